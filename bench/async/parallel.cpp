@@ -0,0 +1,133 @@
+#include <yaclib/async/parallel_for.hpp>
+#include <yaclib/async/parallel_reduce.hpp>
+#include <yaclib/async/parallel_transform.hpp>
+#include <yaclib/exe/submit.hpp>
+#include <yaclib/runtime/fair_thread_pool.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <tuple>
+#include <vector>
+#include <yaclib_std/atomic>
+#include <yaclib_std/thread>
+
+#include <benchmark/benchmark.h>
+
+namespace bench {
+namespace {
+
+// The argument of the parallel benchmarks is the count of threads in the pool
+constexpr std::size_t kSize = std::size_t{1} << 22;
+constexpr std::size_t kGrain = 1024;
+
+double Work(std::size_t i) {
+  return std::sqrt(static_cast<double>(i));
+}
+
+float Kernel(float x) {
+  return x * 2.0F + 1.0F;
+}
+
+void SerialFor(benchmark::State& state) {
+  std::vector<double> out(kSize);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i != kSize; ++i) {
+      out[i] = Work(i);
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kSize));
+}
+
+BENCHMARK(SerialFor)->UseRealTime();
+
+void ParallelFor(benchmark::State& state) {
+  yaclib::FairThreadPool tp{static_cast<std::uint64_t>(state.range(0))};
+  std::vector<double> out(kSize);
+  for (auto _ : state) {
+    std::ignore = std::move(yaclib::ParallelFor(tp, 0, kSize, kGrain, [&](std::size_t i) {
+                    out[i] = Work(i);
+                  })).Get().Ok();
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  tp.Stop();
+  tp.Wait();
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kSize));
+}
+
+BENCHMARK(ParallelFor)->RangeMultiplier(2)->Range(1, 64)->UseRealTime();
+
+void SerialReduce(benchmark::State& state) {
+  for (auto _ : state) {
+    double sum = 0;
+    for (std::size_t i = 0; i != kSize; ++i) {
+      sum += Work(i);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kSize));
+}
+
+BENCHMARK(SerialReduce)->UseRealTime();
+
+void ParallelReduce(benchmark::State& state) {
+  yaclib::FairThreadPool tp{static_cast<std::uint64_t>(state.range(0))};
+  for (auto _ : state) {
+    auto sum = std::move(yaclib::ParallelReduce(tp, 0, kSize, kGrain, 0.0, Work, std::plus<>{})).Get().Ok();
+    benchmark::DoNotOptimize(sum);
+  }
+  tp.Stop();
+  tp.Wait();
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kSize));
+}
+
+BENCHMARK(ParallelReduce)->RangeMultiplier(2)->Range(1, 64)->UseRealTime();
+
+// Job per element, it's what ParallelTransform replaces
+void SubmitTransform(benchmark::State& state) {
+  yaclib::FairThreadPool tp{static_cast<std::uint64_t>(state.range(0))};
+  std::vector<float> in(kSize, 1.0F);
+  std::vector<float> out(kSize);
+  yaclib_std::atomic_size_t done{0};
+  for (auto _ : state) {
+    done.store(0, std::memory_order_relaxed);
+    for (std::size_t i = 0; i != kSize; ++i) {
+      yaclib::Submit(tp, [&, i] {
+        out[i] = Kernel(in[i]);
+        done.fetch_add(1, std::memory_order_release);
+      });
+    }
+    while (done.load(std::memory_order_acquire) != kSize) {
+      yaclib_std::this_thread::yield();
+    }
+    benchmark::DoNotOptimize(out.data());
+  }
+  tp.Stop();
+  tp.Wait();
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kSize));
+}
+
+BENCHMARK(SubmitTransform)->RangeMultiplier(4)->Range(1, 64)->UseRealTime();
+
+void ParallelTransform(benchmark::State& state) {
+  yaclib::FairThreadPool tp{static_cast<std::uint64_t>(state.range(0))};
+  std::vector<float> in(kSize, 1.0F);
+  std::vector<float> out(kSize);
+  for (auto _ : state) {
+    std::ignore = std::move(yaclib::ParallelTransform(tp, in.data(), out.data(), kSize, Kernel)).Get().Ok();
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  tp.Stop();
+  tp.Wait();
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kSize));
+}
+
+BENCHMARK(ParallelTransform)->RangeMultiplier(4)->Range(1, 64)->UseRealTime();
+
+}  // namespace
+}  // namespace bench
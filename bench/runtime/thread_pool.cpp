@@ -0,0 +1,114 @@
+#include <yaclib/exe/job.hpp>
+#include <yaclib/runtime/fair_thread_pool.hpp>
+#include <yaclib/runtime/lock_free_thread_pool.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include <yaclib_std/atomic>
+#include <yaclib_std/thread>
+
+#include <benchmark/benchmark.h>
+
+#if defined(__linux__) || defined(__APPLE__)
+#  include <sys/resource.h>
+#endif
+
+namespace bench {
+namespace {
+
+struct CountJob final : yaclib::Job {
+  void Call() noexcept final {
+    counter->fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void Drop() noexcept final {
+    Call();
+  }
+
+  yaclib_std::atomic_size_t* counter = nullptr;
+};
+
+void Await(const yaclib_std::atomic_size_t& counter, std::size_t count) {
+  while (counter.load(std::memory_order_acquire) != count) {
+    yaclib_std::this_thread::yield();
+  }
+}
+
+// Jobs are preallocated, so only the queue of the pool is measured
+template <typename Pool>
+void Throughput(benchmark::State& state) {
+  constexpr std::size_t kJobs = std::size_t{1} << 18;
+  const auto producers = static_cast<std::size_t>(state.range(0));
+  Pool tp;
+  yaclib_std::atomic_size_t counter{0};
+  std::vector<CountJob> jobs(kJobs);
+  for (auto& job : jobs) {
+    job.counter = &counter;
+  }
+  for (auto _ : state) {
+    counter.store(0, std::memory_order_relaxed);
+    std::vector<std::thread> threads;
+    threads.reserve(producers);
+    for (std::size_t p = 0; p != producers; ++p) {
+      threads.emplace_back([&, p] {
+        for (auto i = p; i < kJobs; i += producers) {
+          tp.Submit(jobs[i]);
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    Await(counter, kJobs);
+  }
+  tp.Stop();
+  tp.Wait();
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kJobs));
+}
+
+BENCHMARK_TEMPLATE(Throughput, yaclib::FairThreadPool)->Arg(1)->Arg(4)->Arg(16)->Arg(64)->UseRealTime();
+BENCHMARK_TEMPLATE(Throughput, yaclib::LockFreeThreadPool)->Arg(1)->Arg(4)->Arg(16)->Arg(64)->UseRealTime();
+
+#if defined(__linux__) || defined(__APPLE__)
+
+std::size_t VoluntarySwitches() {
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+  return static_cast<std::size_t>(usage.ru_nvcsw);
+}
+
+// Every park and wake up of a worker is a voluntary context switch, so it estimates futex syscalls per job.
+// Jobs come in bursts and the producer yields between them, so idle workers park if they don't spin.
+void SwitchesPerJob(benchmark::State& state) {
+  constexpr std::size_t kBurst = 64;
+  const auto spin_budget = static_cast<std::uint32_t>(state.range(0));
+  yaclib::FairThreadPool tp{yaclib_std::thread::hardware_concurrency(), spin_budget};
+  yaclib_std::atomic_size_t counter{0};
+  std::vector<CountJob> jobs(kBurst);
+  for (auto& job : jobs) {
+    job.counter = &counter;
+  }
+  const auto before = VoluntarySwitches();
+  for (auto _ : state) {
+    counter.store(0, std::memory_order_relaxed);
+    for (auto& job : jobs) {
+      tp.Submit(job);
+    }
+    Await(counter, kBurst);
+  }
+  const auto switches = VoluntarySwitches() - before;
+  tp.Stop();
+  tp.Wait();
+  const auto count = static_cast<double>(state.iterations() * kBurst);
+  state.counters["switches_per_job"] = static_cast<double>(switches) / count;
+  state.SetItemsProcessed(static_cast<std::int64_t>(count));
+}
+
+BENCHMARK(SwitchesPerJob)->Arg(0)->Arg(yaclib::FairThreadPool::kSpinBudget)->UseRealTime();
+
+#endif
+
+}  // namespace
+}  // namespace bench
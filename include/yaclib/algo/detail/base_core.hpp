@@ -14,6 +14,11 @@
 
 namespace yaclib::detail {
 
+InlineCore& MakeDrop() noexcept;
+
+// Same as Drop, but also requests stop of the not started callbacks before it
+InlineCore& MakeStop() noexcept;
+
 class BaseCore : public InlineCore {
   friend struct UniqueHandle;
   friend struct SharedHandle;
@@ -24,9 +29,38 @@ class BaseCore : public InlineCore {
     kResult = std::numeric_limits<std::uintptr_t>::max(),
   };
 
+  /**
+   * The low bits of the callback, they tell whether the callback needs the result of this core
+   *
+   * Cancel marks the cancelled core and pushes the mark to its producers, so for the Then chains it's a single load.
+   * The callbacks which decide by themselves, like WhenAny or coroutine, are asked through StopNext.
+   */
+  enum Stop : std::uintptr_t {
+    kNoStop = 0,    // the result is needed
+    kAskStop = 1,   // ask the callback
+    kStopped = 2,   // the result isn't needed
+    kWalking = 3,   // the mark is pushed to the producers right now, ask the callback meanwhile
+  };
+
+  static constexpr std::uintptr_t kStopMask = 3;
+  // Promise::Subscribe stored the job in the next
+  static constexpr std::uintptr_t kSubscribed = 4;
+  static constexpr std::uintptr_t kFlags = kStopMask | kSubscribed;
+
   bool Empty() const noexcept {
     auto callback = _callback.load(std::memory_order_acquire);
-    return callback == kEmpty;
+    return (callback & ~kFlags) == kEmpty;
+  }
+
+  /**
+   * \return true if nobody needs the result of this core anymore, so not started work can be skipped
+   */
+  [[nodiscard]] bool StopRequested() const noexcept {
+    const auto callback = _callback.load(std::memory_order_acquire);
+    if (callback == kResult || (callback & kStopMask) == kNoStop) {
+      return false;
+    }
+    return (callback & kStopMask) == kStopped || AskStop(callback);
   }
 
   template <bool Shared>
@@ -50,31 +84,63 @@ class BaseCore : public InlineCore {
   explicit BaseCore(State state) noexcept : _callback{state} {
   }
 
-  void StoreCallbackImpl(InlineCore& callback) noexcept {
-    this->_callback.store(reinterpret_cast<std::uintptr_t>(&callback), std::memory_order_relaxed);
+  /**
+   * The core which result this core consumes, it's alive until this core has a result
+   */
+  [[nodiscard]] virtual BaseCore* Producer() const noexcept {
+    return nullptr;
   }
 
+  void StoreCallbackImpl(InlineCore& callback, Stop stop = kNoStop) noexcept;
+
   template <bool Shared>
-  [[nodiscard]] bool SetCallbackImpl(InlineCore& callback) noexcept;
+  [[nodiscard]] bool SetCallbackImpl(InlineCore& callback, Stop stop = kNoStop) noexcept;
 
   [[nodiscard]] bool ResetImpl() noexcept;
 
+  // Instead of the callback, so it should be the last action with the core
+  void CancelImpl() noexcept;
+
+  void SubscribeImpl(Job& job) noexcept;
+
+  // Core holds its own stop mark while it replaces the producer, so Cancel doesn't walk to the released one
+  [[nodiscard]] Stop HoldImpl() noexcept;
+
+  void UnholdImpl(Stop stop, BaseCore* producer) noexcept;
+
+  void UnsubscribeImpl() noexcept;
+
+  [[nodiscard]] const InlineCore* StopNext(bool& stop) const noexcept override;
+
   template <bool SymmetricTransfer, bool Shared>
-  [[nodiscard]] Transfer<SymmetricTransfer> SetInlineImpl(InlineCore& callback) noexcept;
+  [[nodiscard]] Transfer<SymmetricTransfer> SetInlineImpl(InlineCore& callback, Stop stop = kNoStop) noexcept;
+
+  // Makes the unique core ready, but doesn't call the callback, so the core and its producer are still alive
+  [[nodiscard]] InlineCore* PublishImpl() noexcept;
 
   template <bool SymmetricTransfer, bool Shared>
   [[nodiscard]] Transfer<SymmetricTransfer> SetResultImpl() noexcept;
 
   yaclib_std::atomic_uintptr_t _callback;
+
+ private:
+  [[nodiscard]] bool AskStop(std::uintptr_t callback) const noexcept;
+
+  // This core is marked with kWalking, pushes the stop mark to the producers, then replaces kWalking with it
+  void Walk(Stop stop, Job* job) noexcept;
+
+  void PushStop() noexcept;
 };
 
+static_assert(alignof(InlineCore) > BaseCore::kFlags, "Callback pointer should have free bits for the flags");
+
 struct UniqueHandle {
-  void StoreCallback(InlineCore& callback) noexcept {
-    core.StoreCallbackImpl(callback);
+  void StoreCallback(InlineCore& callback, BaseCore::Stop stop = BaseCore::kNoStop) noexcept {
+    core.StoreCallbackImpl(callback, stop);
   }
 
-  bool SetCallback(InlineCore& callback) noexcept {
-    return core.SetCallbackImpl<false>(callback);
+  bool SetCallback(InlineCore& callback, BaseCore::Stop stop = BaseCore::kNoStop) noexcept {
+    return core.SetCallbackImpl<false>(callback, stop);
   }
 
   bool Reset() noexcept {
@@ -90,7 +156,8 @@ struct UniqueHandle {
 };
 
 struct SharedHandle {
-  bool SetCallback(InlineCore& callback) noexcept {
+  // Result is always needed, so the stop is ignored
+  bool SetCallback(InlineCore& callback, BaseCore::Stop /*stop*/ = BaseCore::kNoStop) noexcept {
     return core.SetCallbackImpl<true>(callback);
   }
 
@@ -12,8 +12,6 @@
 
 namespace yaclib::detail {
 
-InlineCore& MakeDrop() noexcept;
-
 class NoResultCore : public BaseCore {
  public:
   NoResultCore() noexcept : BaseCore{kEmpty} {
@@ -107,8 +105,28 @@ enum class AsyncType {
   Shared,
 };
 
+// Cancel goes through it to the not started cores before the cancelled one
+template <bool Linked>
+struct ProducerLink {
+  // The previous core in the chain, then the async result of the callback
+  BaseCore* producer = nullptr;
+};
+
+template <>
+struct ProducerLink<false> {};
+
+constexpr bool IsLinked(CoreType type) {
+  return IsFromUnique(type) && IsToUnique(type);
+}
+
+constexpr bool IsAsyncLinked(CoreType type, AsyncType async) {
+  return async == AsyncType::Unique && IsToUnique(type);
+}
+
 template <typename Ret, typename Arg, typename E, typename Func, CoreType Type, AsyncType kAsync>
-class Core : public ResultCoreT<Type, Ret, E>, public FuncCore<Func> {
+class Core : public ResultCoreT<Type, Ret, E>,
+             public FuncCore<Func>,
+             public ProducerLink<IsLinked(Type) || IsAsyncLinked(Type, kAsync)> {
   using F = FuncCore<Func>;
   using Storage = typename F::Storage;
   using Invoke = typename F::Invoke;
@@ -123,8 +141,21 @@ class Core : public ResultCoreT<Type, Ret, E>, public FuncCore<Func> {
   }
 
  private:
+  [[nodiscard]] BaseCore* Producer() const noexcept final {
+    if constexpr (IsLinked(Type) || IsAsyncLinked(Type, kAsync)) {
+      return this->producer;
+    } else {
+      return nullptr;
+    }
+  }
+
   void Call() noexcept final {
     YACLIB_ASSERT(this->_self.unwrapping == 0);
+    if (this->StopRequested()) {
+      // Stop was requested while we were waiting in the executor queue
+      Loop(this, Done<false>(StopTag{}));
+      return;
+    }
     if constexpr (IsRun(Type)) {
       YACLIB_ASSERT(this->_self.caller == nullptr);
       if constexpr (is_invocable_v<Invoke>) {
@@ -168,6 +199,10 @@ class Core : public ResultCoreT<Type, Ret, E>, public FuncCore<Func> {
         // We assume ownership here and release it in Done()
         caller.IncRef();
       }
+      if (this->StopRequested()) {
+        // Nobody needs our result, so we skip not started callback
+        return Done<SymmetricTransfer>(StopTag{});
+      }
       if constexpr (IsCall(Type)) {
         this->_executor->Submit(*this);
         return Noop<SymmetricTransfer>();
@@ -221,13 +256,23 @@ class Core : public ResultCoreT<Type, Ret, E>, public FuncCore<Func> {
     //       kAsync != AsyncType::None: Async operation of our callback can outlive the previous core
     //       - So in the last two cases, we assume ownership of the SharedCore beforehand and release it here
     // If Async, then we always have ownership of the async result of our callback
-    if constexpr ((!IsRun(Type) && (IsFromUnique(Type) || IsCall(Type) || kAsync != AsyncType::None)) || Async) {
+    if constexpr (Async ? IsAsyncLinked(Type, kAsync) : IsLinked(Type)) {
+      // Cancel can walk through this core to the producer until this core is ready, so release it after that
+      if constexpr (!Async) {
+        this->_func.storage.~Storage();
+      }
+      auto* callback = this->PublishImpl();
       caller->DecRef();
+      return callback != nullptr ? Step<SymmetricTransfer>(*this, *callback) : Noop<SymmetricTransfer>();
+    } else {
+      if constexpr ((!IsRun(Type) && (IsFromUnique(Type) || IsCall(Type) || kAsync != AsyncType::None)) || Async) {
+        caller->DecRef();
+      }
+      if constexpr (!Async) {
+        this->_func.storage.~Storage();
+      }
+      return this->template SetResult<SymmetricTransfer>();
     }
-    if constexpr (!Async) {
-      this->_func.storage.~Storage();
-    }
-    return this->template SetResult<SymmetricTransfer>();
   }
 
   template <bool SymmetricTransfer, typename Result>
@@ -278,6 +323,15 @@ class Core : public ResultCoreT<Type, Ret, E>, public FuncCore<Func> {
       // In the case of SharedFuture we also release here because the
       // ownership needs to be 'transferred' into *this
       auto* core = async.GetCore().Release();
+      [[maybe_unused]] auto stop = BaseCore::kNoStop;
+      if constexpr (IsLinked(Type) || IsAsyncLinked(Type, kAsync)) {
+        stop = this->HoldImpl();
+        if constexpr (IsAsyncLinked(Type, kAsync)) {
+          this->producer = core;
+        } else {
+          this->producer = nullptr;
+        }
+      }
       if constexpr (!IsRun(Type)) {
         this->_self.caller->DecRef();
         this->_self.unwrapping = 1;
@@ -286,8 +340,19 @@ class Core : public ResultCoreT<Type, Ret, E>, public FuncCore<Func> {
       this->_func.storage.~Storage();
       if constexpr (is_task_v<decltype(async)>) {
         core->StoreCallback(*this);
+        if constexpr (IsLinked(Type) || IsAsyncLinked(Type, kAsync)) {
+          this->UnholdImpl(stop, core);
+        }
         return Step<SymmetricTransfer>(*this, *MoveToCaller(core));
+      } else if constexpr (IsAsyncLinked(Type, kAsync)) {
+        const bool attached = core->SetCallback(*this);
+        // Until unhold the async result can't publish into this core, so it's still alive
+        this->UnholdImpl(stop, core);
+        return attached ? Noop<SymmetricTransfer>() : Step<SymmetricTransfer>(*core, *this);
       } else {
+        if constexpr (IsLinked(Type)) {
+          this->UnholdImpl(stop, nullptr);
+        }
         return core->template SetInline<SymmetricTransfer>(*this);
       }
     } else {
@@ -410,6 +475,9 @@ auto SetCallback(FromCorePtr&& core, IExecutor* executor, Func&& f) {
       return core.Get();
     }
   }();
+  if constexpr (IsLinked(CoreT | From)) {
+    callback->producer = caller;
+  }
 
   if constexpr (!IsLazy(CoreT)) {
     Loop(caller, caller->template SetInline<false>(*callback));
@@ -10,13 +10,22 @@
 
 namespace yaclib::detail {
 
-class InlineCore : public Job {
+// BaseCore keeps the flags in the low bits of the callback pointer
+class alignas(8) InlineCore : public Job {
  public:
   [[nodiscard]] virtual InlineCore* Here(InlineCore& caller) noexcept = 0;
 
 #if YACLIB_SYMMETRIC_TRANSFER != 0
   [[nodiscard]] virtual yaclib_std::coroutine_handle<> Next(InlineCore& caller) noexcept = 0;
 #endif
+
+  /**
+   * Leaf callback answers whether it needs the result of the caller, core returns its own callback to ask it next
+   */
+  [[nodiscard]] virtual const InlineCore* StopNext(bool& stop) const noexcept {
+    stop = false;
+    return nullptr;
+  }
 };
 
 template <bool SymmetricTransfer>
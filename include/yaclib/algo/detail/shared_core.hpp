@@ -30,16 +30,24 @@ class SharedCore : public ResultCore<V, E> {
     return result;
   }
 
-  [[nodiscard]] bool SetCallback(InlineCore& callback) noexcept {
+  // Result is always needed, so the stop is ignored
+  [[nodiscard]] bool SetCallback(InlineCore& callback, BaseCore::Stop /*stop*/ = BaseCore::kNoStop) noexcept {
     return BaseCore::SetCallbackImpl<true>(callback);
   }
 
+  // Callbacks are the stack and new SharedFuture can come at any moment, so the result is always needed
+  [[nodiscard]] const InlineCore* StopNext(bool& stop) const noexcept final {
+    stop = false;
+    return nullptr;
+  }
+
   // Users should be cautious calling SetInline on a SharedCore
   // because the core's lifetime is managed by the SharedPromise and
   // SharedFutures and they might all be gone by the time
   // the callback is called
   template <bool SymmetricTransfer>
-  [[nodiscard]] Transfer<SymmetricTransfer> SetInline(InlineCore& callback) noexcept {
+  [[nodiscard]] Transfer<SymmetricTransfer> SetInline(InlineCore& callback,
+                                                      BaseCore::Stop /*stop*/ = BaseCore::kNoStop) noexcept {
     return BaseCore::SetInlineImpl<SymmetricTransfer, true>(callback);
   }
 
@@ -32,25 +32,41 @@ class UniqueCore : public ResultCore<V, E> {
     }
   }
 
-  void StoreCallback(InlineCore& callback) noexcept {
-    BaseCore::StoreCallbackImpl(callback);
+  void StoreCallback(InlineCore& callback, BaseCore::Stop stop = BaseCore::kNoStop) noexcept {
+    BaseCore::StoreCallbackImpl(callback, stop);
   }
 
-  [[nodiscard]] bool SetCallback(InlineCore& callback) noexcept {
-    return BaseCore::SetCallbackImpl<false>(callback);
+  /**
+   * \param stop kAskStop if the callback can tell by StopNext that it doesn't need the result
+   */
+  [[nodiscard]] bool SetCallback(InlineCore& callback, BaseCore::Stop stop = BaseCore::kNoStop) noexcept {
+    return BaseCore::SetCallbackImpl<false>(callback, stop);
   }
 
   // Sometimes we know it will be last callback in cycle, so we want call it right now, instead of SetInline
-  void CallInline(InlineCore& callback) noexcept {
-    if (!SetCallback(callback)) {
+  void CallInline(InlineCore& callback, BaseCore::Stop stop = BaseCore::kNoStop) noexcept {
+    if (!SetCallback(callback, stop)) {
       [[maybe_unused]] auto* next = callback.Here(*this);
       YACLIB_ASSERT(next == nullptr);
     }
   }
 
+  void Cancel() noexcept {
+    BaseCore::CancelImpl();
+  }
+
+  void Subscribe(Job& job) noexcept {
+    BaseCore::SubscribeImpl(job);
+  }
+
+  void Unsubscribe() noexcept {
+    BaseCore::UnsubscribeImpl();
+  }
+
   template <bool SymmetricTransfer>
-  [[nodiscard]] Transfer<SymmetricTransfer> SetInline(InlineCore& callback) noexcept {
-    return BaseCore::SetInlineImpl<SymmetricTransfer, false>(callback);
+  [[nodiscard]] Transfer<SymmetricTransfer> SetInline(InlineCore& callback,
+                                                      BaseCore::Stop stop = BaseCore::kNoStop) noexcept {
+    return BaseCore::SetInlineImpl<SymmetricTransfer, false>(callback, stop);
   }
 
   template <bool SymmetricTransfer>
@@ -73,20 +73,6 @@ class OneShotEvent {
     OneShotEvent& _event;
   };
 
-  struct ExtendedAwaiter : Job, BaseAwaiter {
-    using BaseAwaiter::BaseAwaiter;
-
-   protected:
-    void Call() noexcept final {
-      _core->_executor->Submit(*_core);
-    }
-
-    union {
-      IExecutor* _executor;
-      detail::BaseCore* _core;
-    };
-  };
-
   class [[nodiscard]] InlineAwaiter final : public BaseAwaiter {
    public:
     using BaseAwaiter::BaseAwaiter;
@@ -101,9 +87,9 @@ class OneShotEvent {
     }
   };
 
-  class [[nodiscard]] StickyAwaiter final : public ExtendedAwaiter {
+  class [[nodiscard]] StickyAwaiter final : public BaseAwaiter {
    public:
-    using ExtendedAwaiter::ExtendedAwaiter;
+    using BaseAwaiter::BaseAwaiter;
 
     YACLIB_INLINE bool await_ready() const noexcept {
       return _event.Ready();
@@ -111,15 +97,13 @@ class OneShotEvent {
 
     template <typename Promise>
     YACLIB_INLINE bool await_suspend(yaclib_std::coroutine_handle<Promise> handle) noexcept {
-      _core = &handle.promise();
-      return _event.TryAdd(*this);
+      return _event.TryAddSubmit(handle.promise());
     }
   };
 
-  class [[nodiscard]] OnAwaiter final : public ExtendedAwaiter {
+  class [[nodiscard]] OnAwaiter final : public BaseAwaiter {
    public:
-    explicit OnAwaiter(OneShotEvent& event, IExecutor& executor) noexcept : ExtendedAwaiter{event} {
-      _executor = &executor;
+    explicit OnAwaiter(OneShotEvent& event, IExecutor& executor) noexcept : BaseAwaiter{event}, _executor{executor} {
     }
 
     constexpr bool await_ready() const noexcept {
@@ -129,12 +113,14 @@ class OneShotEvent {
     template <typename Promise>
     YACLIB_INLINE void await_suspend(yaclib_std::coroutine_handle<Promise> handle) noexcept {
       auto& core = handle.promise();
-      core._executor = _executor;
-      _core = &core;
-      if (!_event.TryAdd(*this)) {
-        Call();
+      core._executor = &_executor;
+      if (!_event.TryAddSubmit(core)) {
+        _executor.Submit(core);
       }
     }
+
+   private:
+    IExecutor& _executor;
   };
 
  public:
@@ -238,7 +224,15 @@ class OneShotEvent {
     return true;
   }
 
+  /**
+   * Add suspended coroutine, which will be submitted to its executor, so the waiters are submitted by batches
+   */
+  bool TryAddSubmit(detail::BaseCore& core) noexcept;
+
+  bool TryAddImpl(Job& job, std::uintptr_t node) noexcept;
+
   static constexpr auto kEmpty = std::uintptr_t{0};
+  static constexpr auto kSubmit = std::uintptr_t{1};
   static constexpr auto kAllDone = std::numeric_limits<std::uintptr_t>::max();
 
   yaclib_std::atomic_uintptr_t _head = kEmpty;
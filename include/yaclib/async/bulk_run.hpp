@@ -0,0 +1,216 @@
+#pragma once
+
+#include <yaclib/algo/detail/unique_core.hpp>
+#include <yaclib/async/future.hpp>
+#include <yaclib/async/promise.hpp>
+#include <yaclib/exe/executor.hpp>
+#include <yaclib/exe/job.hpp>
+#include <yaclib/util/detail/atomic_counter.hpp>
+#include <yaclib/util/detail/intrusive_list.hpp>
+#include <yaclib/util/result.hpp>
+
+#include <cstddef>
+#include <exception>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <yaclib_std/atomic>
+
+namespace yaclib {
+namespace detail {
+
+template <typename R>
+using BulkOutput = std::conditional_t<std::is_void_v<R>, void, std::vector<R>>;
+
+template <typename R, typename E, typename Func>
+struct BulkDeleter final {
+  template <typename Base>
+  static void Delete(Base& base) noexcept;
+};
+
+template <typename R, typename E, typename Func>
+using BulkBase = AtomicCounter<UniqueCore<BulkOutput<R>, E>, BulkDeleter<R, E, Func>>;
+
+/**
+ * Result core of the BulkRun, it also owns the jobs, their results and the function
+ *
+ * The job slots are placed right after the core in the same allocation, see \ref Make.
+ * References: one for the output future and one for all jobs, the last finished job releases it.
+ */
+template <typename R, typename E, typename Func>
+class BulkCore final : public BulkBase<R, E, Func> {
+  using Output = BulkOutput<R>;
+  struct Slot;
+
+ public:
+  template <typename Arg>
+  static BulkCore* Make(std::size_t n, Arg&& f) {
+    // One block: the core and then n slots
+    auto* memory = ::operator new(SlotsOffset() + n * sizeof(Slot), std::align_val_t{alignof(BulkCore)});
+    try {
+      return new (memory) BulkCore{n, std::forward<Arg>(f)};
+    } catch (...) {
+      ::operator delete(memory, std::align_val_t{alignof(BulkCore)});
+      throw;
+    }
+  }
+
+  void IncRef() noexcept final {
+    this->Add(1);
+  }
+
+  void DecRef() noexcept final {
+    this->Sub(1);
+  }
+
+  std::size_t GetRef() noexcept final {
+    return this->Get(std::memory_order_acquire);
+  }
+
+  void Start(IExecutor& e, std::size_t n) noexcept {
+    if (n == 0) {
+      Complete();
+      return;
+    }
+    List jobs;
+    auto* slots = Slots();
+    for (std::size_t i = 0; i != n; ++i) {
+      jobs.PushBack(slots[i]);
+    }
+    e.SubmitBatch(jobs, n);
+  }
+
+ private:
+  friend struct BulkDeleter<R, E, Func>;
+
+  static constexpr std::size_t SlotsOffset() noexcept {
+    return (sizeof(BulkCore) + alignof(Slot) - 1) / alignof(Slot) * alignof(Slot);
+  }
+
+  template <typename Arg>
+  BulkCore(std::size_t n, Arg&& f) : BulkBase<R, E, Func>{2}, _func{std::forward<Arg>(f)}, _count{n}, _remaining{n} {
+    if constexpr (!std::is_void_v<R>) {
+      _output.resize(n);
+    }
+    auto* slots = Slots();
+    for (std::size_t i = 0; i != n; ++i) {
+      new (slots + i) Slot{};
+      slots[i]._self = this;
+    }
+  }
+
+  Slot* Slots() noexcept {
+    return std::launder(reinterpret_cast<Slot*>(reinterpret_cast<char*>(this) + SlotsOffset()));
+  }
+
+  struct Slot final : Job {
+    void Call() noexcept final {
+      _self->Run(*this);
+    }
+
+    void Drop() noexcept final {
+      _self->Fail(StopTag{});
+      _self->Done();
+    }
+
+    BulkCore* _self = nullptr;
+  };
+
+  void Run(Slot& slot) noexcept {
+    // Nothing is needed after the first error or when the output future is cancelled
+    if (!_failed.load(std::memory_order_relaxed)) {
+      if (this->StopRequested()) {
+        Fail(StopTag{});
+      } else {
+        Invoke(static_cast<std::size_t>(&slot - Slots()));
+      }
+    }
+    Done();
+  }
+
+  void Invoke(std::size_t index) noexcept try {
+    if constexpr (std::is_void_v<R>) {
+      _func(index);
+    } else {
+      _output[index] = _func(index);
+    }
+  } catch (...) {
+    Fail(std::current_exception());
+  }
+
+  template <typename Error>
+  void Fail(Error&& error) noexcept {
+    if (!_failed.exchange(true, std::memory_order_acq_rel)) {
+      _error = Result<Output, E>{std::forward<Error>(error)};
+    }
+  }
+
+  void Done() noexcept {
+    if (_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      Complete();
+    }
+  }
+
+  void Complete() noexcept {
+    Promise<Output, E> promise{UniqueCorePtr<Output, E>{NoRefTag{}, this}};
+    if (_error.State() != ResultState::Empty) {
+      std::move(promise).Set(std::move(_error));
+    } else if constexpr (std::is_void_v<R>) {
+      std::move(promise).Set();
+    } else {
+      std::move(promise).Set(std::move(_output));
+    }
+    this->DecRef();
+  }
+
+  Func _func;
+  const std::size_t _count;
+  yaclib_std::atomic_size_t _remaining;
+  yaclib_std::atomic_bool _failed = false;
+  Result<Output, E> _error;
+  std::conditional_t<std::is_void_v<R>, Unit, std::vector<R>> _output;
+};
+
+template <typename R, typename E, typename Func>
+template <typename Base>
+void BulkDeleter<R, E, Func>::Delete(Base& base) noexcept {
+  using Core = BulkCore<R, E, Func>;
+  auto& core = static_cast<Core&>(base);
+  auto* slots = core.Slots();
+  for (std::size_t i = 0; i != core._count; ++i) {
+    slots[i].~Slot();
+  }
+  core.~Core();
+  ::operator delete(static_cast<void*>(&core), std::align_val_t{alignof(Core)});
+}
+
+}  // namespace detail
+
+/**
+ * Execute f(0), f(1), ..., f(n - 1) on executor
+ *
+ * The output core and all jobs are allocated as one contiguous block and submitted with one
+ * \ref IExecutor::SubmitBatch call. The only other allocation is the std::vector of the results for non-void f.
+ * f is called concurrently, the first exception fails the output and the rest of the calls are skipped.
+ * Calls which aren't started yet are also skipped if the output is cancelled, see \ref Future::Cancel.
+ * \param e executor to be used to execute f and saved as callback executor for return \ref Future
+ * \param n count of calls
+ * \param f func to execute, it receives the index of the call
+ * \return \ref FutureOn with std::vector of the results, in the order of indices, or void for void f
+ */
+template <typename E = StopError, typename Func>
+/*FutureOn*/ auto BulkRun(IExecutor& e, std::size_t n, Func&& f) {
+  using R = std::invoke_result_t<std::decay_t<Func>&, std::size_t>;
+  using Output = detail::BulkOutput<R>;
+  static_assert(std::is_void_v<R> || std::is_default_constructible_v<R>, "Result of f should be default constructible");
+  static_assert(!std::is_same_v<R, bool>, "std::vector<bool> can't be written concurrently");
+  auto* core = detail::BulkCore<R, E, std::decay_t<Func>>::Make(n, std::forward<Func>(f));
+  e.IncRef();
+  core->_executor.Reset(NoRefTag{}, &e);
+  FutureOn<Output, E> output{detail::UniqueCorePtr<Output, E>{NoRefTag{}, core}};
+  core->Start(e, n);
+  return output;
+}
+
+}  // namespace yaclib
@@ -13,7 +13,7 @@ void Connect(FutureBase<V, E>&& f, Promise<V, E>&& p) {
   YACLIB_ASSERT(f.Valid());
   YACLIB_ASSERT(p.Valid());
   YACLIB_ASSERT(f.GetCore() != p.GetCore());
-  if (f.GetCore()->SetCallback(*p.GetCore().Get())) {
+  if (f.GetCore()->SetCallback(*p.GetCore().Get(), detail::BaseCore::kAskStop)) {
     f.GetCore().Release();
     p.GetCore().Release();
   } else {
@@ -25,6 +25,8 @@ template <typename V, typename E>
 void Connect(const SharedFutureBase<V, E>& f, Promise<V, E>&& p) {
   YACLIB_ASSERT(f.Valid());
   YACLIB_ASSERT(p.Valid());
+  // Result of the shared future is always needed, also the stack of its callbacks reuses the subscription storage
+  p.GetCore()->Unsubscribe();
   if (f.GetCore()->SetCallback(*p.GetCore().Get())) {
     p.GetCore().Release();
   } else {
@@ -0,0 +1,234 @@
+#pragma once
+
+#include <yaclib/algo/detail/unique_core.hpp>
+#include <yaclib/async/future.hpp>
+#include <yaclib/async/promise.hpp>
+#include <yaclib/exe/executor.hpp>
+#include <yaclib/exe/job.hpp>
+#include <yaclib/util/helper.hpp>
+#include <yaclib/util/result.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <yaclib_std/atomic>
+#include <yaclib_std/thread>
+
+namespace yaclib::detail {
+
+/**
+ * Typical size of the per core L2 cache, the algorithms over arrays try to keep their working set in it
+ */
+inline constexpr std::size_t kL2CacheSize = 256 * 1024;
+
+/**
+ * Cache line size, it's also enough for the widest vector registers
+ */
+inline constexpr std::size_t kCacheLineSize = 64;
+
+/**
+ * Count of elements in a chunk, so the chunk together with the same sized output fits into L2 cache
+ */
+template <typename T>
+constexpr std::size_t CacheChunk() noexcept {
+  constexpr auto kChunk = kL2CacheSize / 2 / sizeof(T);
+  return kChunk == 0 ? 1 : kChunk;
+}
+
+/**
+ * Result core of the parallel algorithms over an index range, it splits the range and runs Body::Leaf on the parts
+ *
+ * Splitting is lazy: a task processes its range by grain sized leaves, and only splits off the right half of the rest
+ * when every previously spawned task is already started, i.e. when some worker is likely to be idle.
+ * So the count of tasks adapts to the count of workers which actually help, and not to the size of the range.
+ * Tasks are preallocated together, and when all of them are used, the running tasks just don't split anymore.
+ * Every task has its own Body::Partial, the tasks are linked in the order of their ranges, so the partials can be
+ * combined in this order after the last task.
+ *
+ * References: one for the output future and one for all tasks, the last finished task releases it.
+ */
+template <typename V, typename E, typename Body>
+class ParallelCore : public UniqueCore<V, E> {
+  using Partial = typename Body::Partial;
+
+ public:
+  template <typename... Args>
+  explicit ParallelCore(std::size_t tasks, std::size_t grain, Args&&... args)
+    : _tasks{tasks == 0 ? nullptr : new Task[tasks]},
+      _capacity{tasks},
+      _grain{grain == 0 ? 1 : grain},
+      _body{std::forward<Args>(args)...} {
+  }
+
+  void Start(IExecutor& e, std::size_t begin, std::size_t end) noexcept {
+    _spawn = &e;
+    if (begin >= end) {
+      Complete();
+      return;
+    }
+    Spawn(begin, end, nullptr);
+  }
+
+  /**
+   * Count of tasks which is enough for the range: it's bounded by the count of leaves and by the count of workers
+   */
+  static std::size_t TaskCount(std::size_t begin, std::size_t end, std::size_t grain) noexcept {
+    if (begin >= end) {
+      return 0;
+    }
+    grain = grain == 0 ? 1 : grain;
+    const auto leaves = (end - begin - 1) / grain + 1;
+    const std::size_t workers = yaclib_std::thread::hardware_concurrency();
+    return std::min(leaves, kTasksPerWorker * (workers == 0 ? 1 : workers));
+  }
+
+ private:
+  // Each split halves the rest of the range, so it's enough for the few rounds of the balancing per worker
+  static constexpr std::size_t kTasksPerWorker = 64;
+
+  struct Task final : Job {
+    void Call() noexcept final {
+      _self->Run(*this);
+    }
+
+    void Drop() noexcept final {
+      auto& self = *_self;
+      self._queued.fetch_sub(1, std::memory_order_relaxed);
+      self.Fail(StopTag{});
+      self.Done();
+    }
+
+    ParallelCore* _self = nullptr;
+    // Task with the range right after the range of this task, only this task changes it, when it splits
+    Task* _next = nullptr;
+    std::size_t _begin = 0;
+    std::size_t _end = 0;
+    Partial _partial{};
+  };
+
+  // Spawned task is inserted right after its parent, because it takes the right part of the parent range
+  bool Spawn(std::size_t begin, std::size_t end, Task* parent) noexcept {
+    const auto index = _used.fetch_add(1, std::memory_order_relaxed);
+    if (index >= _capacity) {
+      return false;
+    }
+    auto& task = _tasks[index];
+    task._self = this;
+    task._begin = begin;
+    task._end = end;
+    if (parent != nullptr) {
+      task._next = parent->_next;
+      parent->_next = &task;
+    }
+    _count.fetch_add(1, std::memory_order_relaxed);
+    _queued.fetch_add(1, std::memory_order_relaxed);
+    _spawn->Submit(task);
+    return true;
+  }
+
+  void Run(Task& task) noexcept {
+    _queued.fetch_sub(1, std::memory_order_relaxed);
+    auto begin = task._begin;
+    auto end = task._end;
+    bool split = true;
+    while (!Stopped()) {
+      if (end - begin <= _grain) {
+        Leaf(task._partial, begin, end);
+        break;
+      }
+      const auto middle = begin + (end - begin) / 2;
+      if (split && _queued.load(std::memory_order_relaxed) == 0) {
+        split = Spawn(middle, end, &task);
+        if (split) {
+          end = middle;
+        }
+      } else {
+        Leaf(task._partial, begin, begin + _grain);
+        begin += _grain;
+      }
+    }
+    Done();
+  }
+
+  void Leaf(Partial& partial, std::size_t begin, std::size_t end) noexcept try {
+    _body.Leaf(partial, begin, end);
+  } catch (...) {
+    Fail(std::current_exception());
+  }
+
+  // Nothing is needed after the first error or when the output future is cancelled
+  bool Stopped() noexcept {
+    if (_failed.load(std::memory_order_relaxed)) {
+      return true;
+    }
+    if (this->StopRequested()) {
+      Fail(StopTag{});
+      return true;
+    }
+    return false;
+  }
+
+  template <typename Error>
+  void Fail(Error&& error) noexcept {
+    if (!_failed.exchange(true, std::memory_order_acq_rel)) {
+      _error = Result<V, E>{std::forward<Error>(error)};
+    }
+  }
+
+  void Done() noexcept {
+    if (_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      Complete();
+    }
+  }
+
+  void Complete() noexcept {
+    Promise<V, E> promise{UniqueCorePtr<V, E>{NoRefTag{}, this}};
+    if (_error.State() != ResultState::Empty) {
+      std::move(promise).Set(std::move(_error));
+    } else if constexpr (std::is_void_v<V>) {
+      std::move(promise).Set();
+    } else {
+      Output(promise);
+    }
+    this->DecRef();
+  }
+
+  // Body combines the partials here, so it can throw too
+  void Output(Promise<V, E>& promise) noexcept try {
+    // The first task has the range from the begin, the rest are linked after it
+    std::move(promise).Set(_body.Output([&](auto&& fold) {
+      for (auto* task = _capacity == 0 ? nullptr : &_tasks[0]; task != nullptr; task = task->_next) {
+        fold(task->_partial);
+      }
+    }));
+  } catch (...) {
+    std::move(promise).Set(std::current_exception());
+  }
+
+  std::unique_ptr<Task[]> _tasks;
+  std::size_t _capacity;
+  IExecutor* _spawn = nullptr;
+  std::size_t _grain;
+  yaclib_std::atomic_size_t _used = 0;
+  yaclib_std::atomic_size_t _count = 0;
+  yaclib_std::atomic_size_t _queued = 0;
+  yaclib_std::atomic_bool _failed = false;
+  Result<V, E> _error;
+  Body _body;
+};
+
+template <typename V, typename E, typename Body, typename... Args>
+FutureOn<V, E> RunParallel(IExecutor& e, std::size_t begin, std::size_t end, std::size_t grain, Args&&... args) {
+  using Core = ParallelCore<V, E, Body>;
+  auto* core = MakeShared<Core>(2, Core::TaskCount(begin, end, grain), grain, std::forward<Args>(args)...).Release();
+  e.IncRef();
+  core->_executor.Reset(NoRefTag{}, &e);
+  FutureOn<V, E> output{UniqueCorePtr<V, E>{NoRefTag{}, core}};
+  core->Start(e, begin, end);
+  return output;
+}
+
+}  // namespace yaclib::detail
@@ -0,0 +1,240 @@
+#pragma once
+
+#include <yaclib/algo/detail/inline_core.hpp>
+#include <yaclib/algo/detail/unique_core.hpp>
+#include <yaclib/async/future.hpp>
+#include <yaclib/async/promise.hpp>
+#include <yaclib/exe/executor.hpp>
+#include <yaclib/util/cast.hpp>
+#include <yaclib/util/detail/intrusive_list.hpp>
+#include <yaclib/util/detail/spinlock.hpp>
+#include <yaclib/util/fail_policy.hpp>
+#include <yaclib/util/helper.hpp>
+#include <yaclib/util/result.hpp>
+#include <yaclib/util/type_traits.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <yaclib_std/atomic>
+
+namespace yaclib {
+namespace detail {
+
+/**
+ * Result core of the ForEachConcurrent, it owns the slots, every slot processes items one by one
+ *
+ * A slot is both the job, which takes the next item, and the callback of the future returned for the item.
+ * References: one for the output future and one for all slots, the last finished slot releases it.
+ */
+template <FailPolicy F, typename E, typename It, typename Func>
+class ForEachCore : public UniqueCore<void, E> {
+  using R = std::invoke_result_t<Func&, decltype(*std::declval<It&>())>;
+
+ public:
+  template <typename Arg>
+  ForEachCore(It begin, It end, std::size_t slots, Arg&& f)
+    : _cursor{begin}, _end{end}, _remaining{slots}, _slots{new Slot[slots]}, _func{std::forward<Arg>(f)} {
+  }
+
+  void Start(IExecutor& e, std::size_t slots) noexcept {
+    _spawn = &e;
+    List jobs;
+    for (std::size_t i = 0; i != slots; ++i) {
+      _slots[i]._self = this;
+      jobs.PushBack(_slots[i]);
+    }
+    e.SubmitBatch(jobs, slots);
+  }
+
+ private:
+  struct Slot final : InlineCore {
+    void Call() noexcept final {
+      _self->Loop(*this);
+    }
+
+    void Drop() noexcept final {
+      _self->Stop(StopTag{});
+      _self->Done();
+    }
+
+    [[nodiscard]] InlineCore* Here(InlineCore& caller) noexcept final {
+      _self->Resume(*this, caller);
+      return nullptr;
+    }
+
+#if YACLIB_SYMMETRIC_TRANSFER != 0
+    [[nodiscard]] yaclib_std::coroutine_handle<> Next(InlineCore& caller) noexcept final {
+      _self->Resume(*this, caller);
+      return yaclib_std::noop_coroutine();
+    }
+#endif
+
+    [[nodiscard]] const InlineCore* StopNext(bool& stop) const noexcept final {
+      stop = _self->_stop.load(std::memory_order_acquire);
+      return nullptr;
+    }
+
+    ForEachCore* _self = nullptr;
+  };
+
+  void Loop(Slot& slot) noexcept {
+    while (!Stopped()) {
+      auto it = Claim();
+      if (!it) {
+        break;
+      }
+      if constexpr (is_future_base_v<R>) {
+        typename R::Core* core = nullptr;
+        try {
+          core = _func(**it).GetCore().Release();
+        } catch (...) {
+          Fail(std::current_exception());
+          continue;
+        }
+        if (core->SetCallback(slot, BaseCore::kAskStop)) {
+          // The slot continues in Resume, when the future is ready
+          return;
+        }
+        Consume(*core);
+      } else {
+        try {
+          _func(**it);
+        } catch (...) {
+          Fail(std::current_exception());
+        }
+      }
+    }
+    Done();
+  }
+
+  void Resume(Slot& slot, InlineCore& caller) noexcept {
+    if constexpr (is_future_base_v<R>) {
+      Consume(DownCast<typename R::Core>(caller));
+      _spawn->Submit(slot);
+    }
+  }
+
+  std::optional<It> Claim() noexcept {
+    std::lock_guard lock{_cursor_lock};
+    if (_cursor == _end) {
+      return std::nullopt;
+    }
+    return _cursor++;
+  }
+
+  template <typename Core>
+  void Consume(Core& core) noexcept {
+    auto result = core.Retire();
+    if (result.State() == ResultState::Exception) {
+      Fail(std::as_const(result).Exception());
+    } else if (result.State() == ResultState::Error) {
+      Fail(std::as_const(result).Error());
+    }
+  }
+
+  // Nothing is needed after the first error with FirstFail or when the output future is cancelled
+  bool Stopped() noexcept {
+    if (_stop.load(std::memory_order_acquire)) {
+      return true;
+    }
+    if (this->StopRequested()) {
+      Stop(StopTag{});
+      return true;
+    }
+    return false;
+  }
+
+  template <typename Error>
+  void Fail(Error&& error) noexcept {
+    if constexpr (F == FailPolicy::FirstFail) {
+      Stop(std::forward<Error>(error));
+    } else if constexpr (F == FailPolicy::LastFail) {
+      std::lock_guard lock{_error_lock};
+      _error = Result<void, E>{std::forward<Error>(error)};
+    }
+  }
+
+  template <typename Error>
+  void Stop(Error&& error) noexcept {
+    std::lock_guard lock{_error_lock};
+    if (!_stop.load(std::memory_order_relaxed)) {
+      _stop.store(true, std::memory_order_release);
+      _error = Result<void, E>{std::forward<Error>(error)};
+    }
+  }
+
+  void Done() noexcept {
+    if (_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      Complete();
+    }
+  }
+
+  void Complete() noexcept {
+    Promise<void, E> promise{UniqueCorePtr<void, E>{NoRefTag{}, this}};
+    if (_error.State() != ResultState::Empty) {
+      std::move(promise).Set(std::move(_error));
+    } else {
+      std::move(promise).Set();
+    }
+    this->DecRef();
+  }
+
+  IExecutor* _spawn = nullptr;
+  Spinlock<bool> _cursor_lock;
+  It _cursor;
+  It _end;
+  yaclib_std::atomic_size_t _remaining;
+  yaclib_std::atomic_bool _stop = false;
+  Spinlock<bool> _error_lock;
+  Result<void, E> _error;
+  std::unique_ptr<Slot[]> _slots;
+  Func _func;
+};
+
+}  // namespace detail
+
+/**
+ * Execute f for every item of [begin, end) on executor, with at most max_in_flight calls in progress
+ *
+ * If f returns \ref Future, the item is in progress until the future is ready, so it's a limit for async operations.
+ * Every of max_in_flight slots takes the next item as soon as its previous item is done,
+ * and all slots are allocated once, so nothing is allocated per item, except what f allocates itself.
+ * \tparam F how exceptions from f and failed futures are handled:
+ *   FirstFail -- the first failure fails the output and items which aren't started yet are skipped
+ *   LastFail -- all items are processed, the output fails with the last failure
+ *   None -- all items are processed, failures are ignored
+ * Items which aren't started yet are also skipped if the output is cancelled, see \ref Future::Cancel.
+ * Range should be alive and not changed until the future is ready, items are taken in order under a lock.
+ * \param e executor to be used to execute f and saved as callback executor for return \ref Future
+ * \param max_in_flight count of items in progress, 0 is the same as 1
+ * \return \ref FutureOn which is ready when all items are done or skipped
+ */
+template <FailPolicy F = FailPolicy::FirstFail, typename E = StopError, typename It, typename Func>
+FutureOn<void, E> ForEachConcurrent(IExecutor& e, It begin, It end, std::size_t max_in_flight, Func&& f) {
+  using R = std::invoke_result_t<std::decay_t<Func>&, decltype(*begin)>;
+  if constexpr (is_future_base_v<R>) {
+    static_assert(std::is_same_v<typename R::Core::Error, E>, "Future returned by f should have the same error type");
+  }
+  auto slots = std::max(max_in_flight, std::size_t{1});
+  if constexpr (std::is_base_of_v<std::random_access_iterator_tag,
+                                  typename std::iterator_traits<It>::iterator_category>) {
+    // At least one slot to complete the output
+    slots = std::clamp(static_cast<std::size_t>(end - begin), std::size_t{1}, slots);
+  }
+  using Core = detail::ForEachCore<F, E, It, std::decay_t<Func>>;
+  auto* core = MakeShared<Core>(2, begin, end, slots, std::forward<Func>(f)).Release();
+  e.IncRef();
+  core->_executor.Reset(NoRefTag{}, &e);
+  FutureOn<void, E> output{detail::UniqueCorePtr<void, E>{NoRefTag{}, core}};
+  core->Start(e, slots);
+  return output;
+}
+
+}  // namespace yaclib
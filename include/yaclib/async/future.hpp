@@ -147,6 +147,16 @@ class FutureBase {
     core->CallInline(detail::MakeDrop());
   }
 
+  /**
+   * Request stop and \ref Detach *this
+   *
+   * Not started callbacks which compute *this will be skipped with StopError,
+   * \ref Promise can check it with \ref Promise::StopRequested.
+   */
+  void Cancel() && noexcept {
+    _core.Release()->Cancel();
+  }
+
   /**
    * Attach the final continuation func to *this and \ref Detach *this
    *
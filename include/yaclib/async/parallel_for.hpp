@@ -0,0 +1,49 @@
+#pragma once
+
+#include <yaclib/async/detail/parallel_core.hpp>
+#include <yaclib/async/future.hpp>
+#include <yaclib/exe/executor.hpp>
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace yaclib {
+namespace detail {
+
+template <typename Func>
+struct ForBody {
+  struct Partial {};
+
+  void Leaf(Partial& /*partial*/, std::size_t begin, std::size_t end) {
+    for (; begin != end; ++begin) {
+      func(begin);
+    }
+  }
+
+  Func func;
+};
+
+}  // namespace detail
+
+/**
+ * Execute f(i) for every i in [begin, end) on executor
+ *
+ * The range is split lazily: a job processes grain sized parts of its range and splits off a half of the rest only
+ * when there are no spawned jobs waiting in the executor, so it adapts to the count of really idle workers.
+ * The first exception fails the output and the rest of the range is skipped, the same is done if it's cancelled.
+ * \param e executor to be used to execute f and saved as callback executor for return \ref Future
+ * \param begin first index
+ * \param end index after the last one
+ * \param grain count of indices which are executed without checking for split or stop, 0 is the same as 1
+ * \param f func to execute, it receives the index
+ * \return \ref FutureOn which is ready when all calls are done, it can be awaited from a coroutine
+ */
+template <typename E = StopError, typename Func>
+FutureOn<void, E> ParallelFor(IExecutor& e, std::size_t begin, std::size_t end, std::size_t grain, Func&& f) {
+  static_assert(std::is_invocable_v<std::decay_t<Func>&, std::size_t>, "f should be invocable with an index");
+  using Body = detail::ForBody<std::decay_t<Func>>;
+  return detail::RunParallel<void, E, Body>(e, begin, end, grain, std::forward<Func>(f));
+}
+
+}  // namespace yaclib
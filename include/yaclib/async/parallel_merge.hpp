@@ -0,0 +1,77 @@
+#pragma once
+
+#include <yaclib/async/detail/parallel_core.hpp>
+#include <yaclib/async/parallel_for.hpp>
+#include <yaclib/exe/executor.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+namespace yaclib {
+namespace detail {
+
+/**
+ * Count of elements of a in the first k elements of the stable merge of a and b
+ */
+template <typename ItA, typename ItB, typename Compare>
+std::size_t CoRank(std::size_t k, ItA a, std::size_t size_a, ItB b, std::size_t size_b, Compare& comp) {
+  auto lo = k > size_b ? k - size_b : 0;
+  auto hi = std::min(k, size_a);
+  while (lo < hi) {
+    const auto middle = lo + (hi - lo) / 2;
+    // a[middle] is taken before b[k - middle - 1], so more elements of a are needed
+    if (!comp(b[k - middle - 1], a[middle])) {
+      lo = middle + 1;
+    } else {
+      hi = middle;
+    }
+  }
+  return lo;
+}
+
+/**
+ * Write [begin, end) part of the stable merge of a and b into out, where out points to the start of the whole merge
+ *
+ * So every part of the merge can be computed independently, and all parts are the same size.
+ */
+template <typename ItA, typename ItB, typename Out, typename Compare>
+void MergePart(std::size_t begin, std::size_t end, ItA a, std::size_t size_a, ItB b, std::size_t size_b, Out out,
+               Compare& comp) {
+  const auto a_begin = CoRank(begin, a, size_a, b, size_b, comp);
+  const auto a_end = CoRank(end, a, size_a, b, size_b, comp);
+  const auto b_begin = begin - a_begin;
+  const auto b_end = end - a_end;
+  std::merge(std::make_move_iterator(a + a_begin), std::make_move_iterator(a + a_end),
+             std::make_move_iterator(b + b_begin), std::make_move_iterator(b + b_end), out + begin, comp);
+}
+
+}  // namespace detail
+
+/**
+ * Stable merge of the sorted ranges [first1, last1) and [first2, last2) into the range starting at out on executor
+ *
+ * The output is split into cache sized chunks, and the part of every input for a chunk is found with binary search,
+ * so no temporary memory is used and the work doesn't depend on how the values are distributed between the inputs.
+ * All ranges should be alive and not used until the future is ready, the output shouldn't overlap the inputs.
+ * \param e executor to be used to merge and saved as callback executor for return \ref Future
+ * \param comp strict weak ordering, the inputs should be sorted with it
+ * \return \ref FutureOn which is ready when the output is written, it can be awaited from a coroutine
+ */
+template <typename E = StopError, typename ItA, typename ItB, typename Out, typename Compare = std::less<>>
+FutureOn<void, E> ParallelMerge(IExecutor& e, ItA first1, ItA last1, ItB first2, ItB last2, Out out,
+                                Compare comp = {}) {
+  using T = typename std::iterator_traits<Out>::value_type;
+  const auto size_a = static_cast<std::size_t>(last1 - first1);
+  const auto size_b = static_cast<std::size_t>(last2 - first2);
+  const auto size = size_a + size_b;
+  constexpr auto kChunk = detail::CacheChunk<T>();
+  return ParallelFor<E>(e, 0, (size + kChunk - 1) / kChunk, 1, [=](std::size_t chunk) mutable {
+    const auto begin = chunk * kChunk;
+    detail::MergePart(begin, std::min(begin + kChunk, size), first1, size_a, first2, size_b, out, comp);
+  });
+}
+
+}  // namespace yaclib
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <yaclib/async/detail/parallel_core.hpp>
+#include <yaclib/async/future.hpp>
+#include <yaclib/exe/executor.hpp>
+
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace yaclib {
+namespace detail {
+
+template <typename T, typename Map, typename Reduce>
+class ReduceBody {
+ public:
+  template <typename Identity, typename MapArg, typename ReduceArg>
+  ReduceBody(Identity&& identity, MapArg&& map, ReduceArg&& reduce)
+    : _identity{std::forward<Identity>(identity)}
+    , _map{std::forward<MapArg>(map)}
+    , _reduce{std::forward<ReduceArg>(reduce)} {
+  }
+
+  // Empty for the task which didn't finish any leaf
+  using Partial = std::optional<T>;
+
+  void Leaf(Partial& partial, std::size_t begin, std::size_t end) {
+    if (!partial) {
+      partial.emplace(_identity);
+    }
+    for (; begin != end; ++begin) {
+      *partial = _reduce(std::move(*partial), _map(begin));
+    }
+  }
+
+  // Partials are passed in the order of their ranges
+  template <typename Each>
+  T Output(Each&& each) {
+    Partial acc;
+    each([&](Partial& partial) {
+      if (!partial) {
+        return;
+      }
+      if (acc) {
+        *acc = _reduce(std::move(*acc), std::move(*partial));
+      } else {
+        acc.emplace(std::move(*partial));
+      }
+    });
+    return acc ? std::move(*acc) : std::move(_identity);
+  }
+
+ private:
+  T _identity;
+  Map _map;
+  Reduce _reduce;
+};
+
+}  // namespace detail
+
+/**
+ * Compute reduce(...reduce(identity, map(begin))..., map(end - 1)) for the range [begin, end) on executor
+ *
+ * The range is split in the same way as in \ref ParallelFor, every task folds its leaves into its own value
+ * started from identity, and these values are folded together in the order of their ranges after the last task.
+ * So reduce should be associative, but it doesn't need to be commutative, and identity should be the identity element for it.
+ * \param e executor to be used to execute map and reduce and saved as callback executor for return \ref Future
+ * \param begin first index
+ * \param end index after the last one
+ * \param grain count of indices which are folded without checking for split or stop, 0 is the same as 1
+ * \param identity result for the empty range
+ * \param map func which receives the index and returns a value for reduce
+ * \param reduce func which folds two values
+ * \return \ref FutureOn with the folded value, it can be awaited from a coroutine
+ */
+template <typename E = StopError, typename T, typename Map, typename Reduce>
+FutureOn<std::decay_t<T>, E> ParallelReduce(IExecutor& e, std::size_t begin, std::size_t end, std::size_t grain,
+                                            T&& identity, Map&& map, Reduce&& reduce) {
+  using V = std::decay_t<T>;
+  static_assert(std::is_copy_constructible_v<V>, "identity is copied into every leaf");
+  using Body = detail::ReduceBody<V, std::decay_t<Map>, std::decay_t<Reduce>>;
+  return detail::RunParallel<V, E, Body>(e, begin, end, grain, std::forward<T>(identity), std::forward<Map>(map),
+                                         std::forward<Reduce>(reduce));
+}
+
+}  // namespace yaclib
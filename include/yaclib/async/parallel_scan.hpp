@@ -0,0 +1,54 @@
+#pragma once
+
+#include <yaclib/async/detail/parallel_core.hpp>
+#include <yaclib/async/parallel_for.hpp>
+#include <yaclib/exe/executor.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <utility>
+
+namespace yaclib {
+
+/**
+ * Write the inclusive prefix fold of the range [first, last) with op into the range starting at out on executor
+ *
+ * Every cache sized chunk is scanned independently, then the last values of the chunks are fixed up serially,
+ * and at last the rest of every chunk is folded with the last value of the previous chunk.
+ * No temporary memory is used, the chunk totals are kept in the output itself. out can be equal to first.
+ * The ranges should be alive and not used until the future is ready.
+ * \param e executor to be used to scan and saved as callback executor for return \ref Future
+ * \param op associative binary operation
+ * \return \ref FutureOn which is ready when the output is written, it can be awaited from a coroutine
+ */
+template <typename E = StopError, typename It, typename Out, typename Op = std::plus<>>
+FutureOn<void, E> ParallelInclusiveScan(IExecutor& e, It first, It last, Out out, Op op = {}) {
+  using T = typename std::iterator_traits<Out>::value_type;
+  constexpr auto kChunk = detail::CacheChunk<T>();
+  const auto size = static_cast<std::size_t>(last - first);
+  const auto chunks = (size + kChunk - 1) / kChunk;
+  const auto end = [size](std::size_t chunk) {
+    return std::min(size, (chunk + 1) * kChunk);
+  };
+  return ParallelFor<E>(e, 0, chunks, 1,
+                        [=](std::size_t chunk) mutable {
+                          const auto begin = chunk * kChunk;
+                          std::inclusive_scan(first + begin, first + end(chunk), out + begin, op);
+                        })
+    .ThenInline([=, &e]() mutable {
+      for (std::size_t chunk = 1; chunk < chunks; ++chunk) {
+        out[end(chunk) - 1] = op(out[end(chunk - 1) - 1], out[end(chunk) - 1]);
+      }
+      return ParallelFor<E>(e, 1, chunks, 1, [=](std::size_t chunk) mutable {
+        const auto carry = out[chunk * kChunk - 1];
+        std::for_each(out + chunk * kChunk, out + end(chunk) - 1, [&](T& value) {
+          value = op(carry, value);
+        });
+      });
+    });
+}
+
+}  // namespace yaclib
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <yaclib/async/detail/parallel_core.hpp>
+#include <yaclib/async/parallel_for.hpp>
+#include <yaclib/async/parallel_merge.hpp>
+#include <yaclib/exe/executor.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace yaclib {
+namespace detail {
+
+template <typename It, typename Compare>
+class SortState {
+  using T = typename std::iterator_traits<It>::value_type;
+  static constexpr auto kChunk = CacheChunk<T>();
+
+ public:
+  SortState(It first, std::size_t size, Compare comp)
+    : _first{first}, _size{size}, _buffer(size > kChunk ? size : 0), _comp{std::move(comp)} {
+  }
+
+  [[nodiscard]] std::size_t Chunks() const noexcept {
+    return (_size + kChunk - 1) / kChunk;
+  }
+
+  void Sort(std::size_t chunk) {
+    const auto begin = _first + chunk * kChunk;
+    std::sort(begin, begin + Length(chunk), _comp);
+  }
+
+  // Even passes merge from the input to the buffer, odd ones back
+  void Merge(std::size_t pass, std::size_t chunk) {
+    if (pass % 2 == 0) {
+      Merge(_first, _buffer.data(), pass, chunk);
+    } else {
+      Merge(_buffer.data(), _first, pass, chunk);
+    }
+  }
+
+  void MoveBack(std::size_t chunk) {
+    const auto begin = chunk * kChunk;
+    std::move(_buffer.data() + begin, _buffer.data() + begin + Length(chunk), _first + begin);
+  }
+
+ private:
+  [[nodiscard]] std::size_t Length(std::size_t chunk) const noexcept {
+    return std::min(kChunk, _size - chunk * kChunk);
+  }
+
+  template <typename Src, typename Dst>
+  void Merge(Src src, Dst dst, std::size_t pass, std::size_t chunk) {
+    const auto width = kChunk << pass;
+    const auto begin = chunk * kChunk;
+    const auto start = begin / (2 * width) * (2 * width);
+    const auto size_a = std::min(width, _size - start);
+    const auto size_b = std::min(start + 2 * width, _size) - start - size_a;
+    MergePart(begin - start, begin - start + Length(chunk), src + start, size_a, src + start + size_a, size_b,
+              dst + start, _comp);
+  }
+
+  It _first;
+  std::size_t _size;
+  std::vector<T> _buffer;
+  Compare _comp;
+};
+
+}  // namespace detail
+
+/**
+ * Sort the range [first, last) on executor
+ *
+ * It's a merge sort: cache sized chunks are sorted with std::sort, then they are merged pairwise until one run left.
+ * Every merge pass is split into the same cache sized chunks of the output, see \ref ParallelMerge,
+ * so the last passes are as parallel as the first ones. The only temporary memory is one buffer of the range size,
+ * it isn't allocated if the range fits in one chunk. The sort isn't stable, because chunks are sorted with std::sort.
+ * The range should be alive and not used until the future is ready.
+ * \param e executor to be used to sort and saved as callback executor for return \ref Future
+ * \param comp strict weak ordering
+ * \return \ref FutureOn which is ready when the range is sorted, it can be awaited from a coroutine
+ */
+template <typename E = StopError, typename It, typename Compare = std::less<>>
+FutureOn<void, E> ParallelSort(IExecutor& e, It first, It last, Compare comp = {}) {
+  auto state = std::make_shared<detail::SortState<It, Compare>>(first, static_cast<std::size_t>(last - first),
+                                                                std::move(comp));
+  const auto chunks = state->Chunks();
+  auto f = ParallelFor<E>(e, 0, chunks, 1, [state](std::size_t chunk) {
+    state->Sort(chunk);
+  });
+  std::size_t pass = 0;
+  for (; (std::size_t{1} << pass) < chunks; ++pass) {
+    f = std::move(f).ThenInline([&e, state, chunks, pass] {
+      return ParallelFor<E>(e, 0, chunks, 1, [state, pass](std::size_t chunk) {
+        state->Merge(pass, chunk);
+      });
+    });
+  }
+  if (pass % 2 != 0) {
+    f = std::move(f).ThenInline([&e, state, chunks] {
+      return ParallelFor<E>(e, 0, chunks, 1, [state](std::size_t chunk) {
+        state->MoveBack(chunk);
+      });
+    });
+  }
+  return f;
+}
+
+}  // namespace yaclib
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <yaclib/async/detail/parallel_core.hpp>
+#include <yaclib/async/parallel_for.hpp>
+#include <yaclib/exe/executor.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace yaclib {
+namespace detail {
+
+template <typename In, typename Out, typename Kernel>
+class TransformBody {
+  // Elements of Out in a cache line, chunks are multiple of it so every chunk except the first starts on a line
+  static constexpr std::size_t kLine = kCacheLineSize % sizeof(Out) == 0 ? kCacheLineSize / sizeof(Out) : 1;
+  static constexpr std::size_t kChunk =
+    std::max(kL2CacheSize / 2 / std::max(sizeof(In), sizeof(Out)) / kLine, std::size_t{1}) * kLine;
+
+ public:
+  TransformBody(const In* in, Out* out, std::size_t size, Kernel kernel) noexcept
+    : _in{in}, _out{out}, _size{size}, _kernel{std::move(kernel)} {
+    const auto misaligned = reinterpret_cast<std::uintptr_t>(out) % kCacheLineSize;
+    if (kLine != 1 && misaligned % sizeof(Out) == 0) {
+      _head = std::min((kCacheLineSize - misaligned) % kCacheLineSize / sizeof(Out), size);
+    }
+  }
+
+  [[nodiscard]] std::size_t Chunks() const noexcept {
+    return _size == 0 ? 0 : std::max((_size - _head + kChunk - 1) / kChunk, std::size_t{1});
+  }
+
+  void operator()(std::size_t chunk) {
+    // The first chunk also takes unaligned head
+    const auto begin = chunk == 0 ? 0 : _head + chunk * kChunk;
+    const auto end = std::min(_head + (chunk + 1) * kChunk, _size);
+    if constexpr (std::is_invocable_v<Kernel&, const In*, Out*, std::size_t>) {
+      _kernel(_in + begin, _out + begin, end - begin);
+    } else {
+      const auto* in = _in;
+      auto* out = _out;
+      for (auto i = begin; i != end; ++i) {
+        out[i] = _kernel(in[i]);
+      }
+    }
+  }
+
+ private:
+  const In* _in;
+  Out* _out;
+  std::size_t _size;
+  std::size_t _head = 0;
+  Kernel _kernel;
+};
+
+}  // namespace detail
+
+/**
+ * Write kernel results for the contiguous input [in, in + size) into the contiguous output [out, out + size)
+ *
+ * The output is split into cache sized chunks, which are multiple of cache line, and only the first chunk takes
+ * the part before the first cache line boundary. So every other chunk starts and, except the last one, ends aligned,
+ * and the compiler or the kernel don't need scalar peel loops for them.
+ * kernel can be a function of one element, which returns the output element, so the loop over a chunk is simple for
+ * auto-vectorization, or a function of (const In* in, Out* out, std::size_t count) for manually vectorized code.
+ * Input and output should be alive and not used until the future is ready, out can be equal to in.
+ * \param e executor to be used to execute kernel and saved as callback executor for return \ref Future
+ * \return \ref FutureOn which is ready when the output is written, it can be awaited from a coroutine
+ */
+template <typename E = StopError, typename In, typename Out, typename Kernel>
+FutureOn<void, E> ParallelTransform(IExecutor& e, const In* in, Out* out, std::size_t size, Kernel&& kernel) {
+  detail::TransformBody<In, Out, std::decay_t<Kernel>> body{in, out, size, std::forward<Kernel>(kernel)};
+  const auto chunks = body.Chunks();
+  return ParallelFor<E>(e, 0, chunks, 1, std::move(body));
+}
+
+}  // namespace yaclib
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <yaclib/algo/detail/unique_core.hpp>
+#include <yaclib/exe/detail/unique_job.hpp>
 #include <yaclib/fwd.hpp>
 #include <yaclib/util/type_traits.hpp>
 
@@ -44,6 +45,38 @@ class Promise final {
     return _core != nullptr;
   }
 
+  /**
+   * Check if the result isn't needed anymore, because \ref Future or its continuation was cancelled
+   *
+   * It's cheap enough to poll it in the long computation.
+   */
+  [[nodiscard]] bool StopRequested() const& noexcept {
+    YACLIB_ASSERT(Valid());
+    return _core->StopRequested();
+  }
+
+  /**
+   * Call the job when \ref Future or its continuation is cancelled, instead of polling \ref StopRequested
+   *
+   * The job is called once by the cancelling thread, or right here if stop is already requested.
+   * If the result is set without the stop request, the job is dropped instead.
+   * \note Stop requested by combinators, like WhenAny, is visible only through \ref StopRequested
+   * \note At most one subscription for the Promise, the job should be alive until it's called or dropped
+   */
+  void Subscribe(Job& job) & noexcept {
+    YACLIB_ASSERT(Valid());
+    _core->Subscribe(job);
+  }
+
+  /**
+   * Subscribe the func, for details \see Subscribe(Job&)
+   */
+  template <typename Func, typename = std::enable_if_t<!std::is_base_of_v<Job, std::decay_t<Func>>>>
+  void Subscribe(Func&& f) & {
+    auto* job = detail::MakeUniqueJob(std::forward<Func>(f));
+    Subscribe(*job);
+  }
+
   /**
    * Set \ref Promise result
    *
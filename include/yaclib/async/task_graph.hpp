@@ -0,0 +1,288 @@
+#pragma once
+
+#include <yaclib/algo/detail/unique_core.hpp>
+#include <yaclib/async/future.hpp>
+#include <yaclib/async/promise.hpp>
+#include <yaclib/exe/executor.hpp>
+#include <yaclib/exe/job.hpp>
+#include <yaclib/log.hpp>
+#include <yaclib/util/detail/atomic_counter.hpp>
+#include <yaclib/util/detail/intrusive_list.hpp>
+#include <yaclib/util/detail/set_deleter.hpp>
+#include <yaclib/util/result.hpp>
+
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <yaclib_std/atomic>
+
+namespace yaclib {
+
+/**
+ * Exception of the \ref TaskGraph::Run output if the graph has a cycle
+ */
+struct TaskGraphCycleError final : std::exception {
+  const char* what() const noexcept final {
+    return "yaclib::TaskGraphCycleError";
+  }
+};
+
+namespace detail {
+
+/**
+ * Output core of the TaskGraph run, it's embedded in the graph and only reconstructed for the next run
+ */
+template <typename E>
+class GraphCore final : public AtomicCounter<UniqueCore<void, E>, NopeDeleter> {
+ public:
+  using AtomicCounter<UniqueCore<void, E>, NopeDeleter>::AtomicCounter;
+
+  void IncRef() noexcept final {
+    this->Add(1);
+  }
+
+  void DecRef() noexcept final {
+    this->Sub(1);
+  }
+
+  std::size_t GetRef() noexcept final {
+    return this->Get(std::memory_order_acquire);
+  }
+};
+
+}  // namespace detail
+
+/**
+ * Reusable graph of tasks with dependencies
+ *
+ * Nodes and edges are declared once, then the graph can be run many times.
+ * Every node is a preallocated job with the dependency counter, which is reset at the start of every run.
+ * When a node is done, it submits its successors which became ready, and runs the last of them inline.
+ * Run doesn't allocate, except for the first run after the graph is changed.
+ */
+template <typename E = StopError>
+class TaskGraph final {
+ public:
+  using NodeId = std::size_t;
+
+  TaskGraph() = default;
+  TaskGraph(TaskGraph&&) = delete;
+  TaskGraph& operator=(TaskGraph&&) = delete;
+
+  ~TaskGraph() {
+    YACLIB_ASSERT(Idle());
+  }
+
+  /**
+   * Add node which executes f
+   *
+   * \param f func without arguments, if it throws, the run fails and nodes which aren't started yet are skipped
+   * \return id of the node for \ref Precede
+   */
+  template <typename Func>
+  NodeId Add(Func&& f) {
+    YACLIB_ASSERT(Idle());
+    _nodes.push_back(std::make_unique<FuncNode<std::decay_t<Func>>>(*this, std::forward<Func>(f)));
+    _roots.clear();
+    return _nodes.size() - 1;
+  }
+
+  /**
+   * Add edge, so after is started only when before is done
+   *
+   * The graph should stay acyclic, otherwise Run fails with \ref TaskGraphCycleError without running any node.
+   */
+  void Precede(NodeId before, NodeId after) {
+    YACLIB_ASSERT(Idle());
+    YACLIB_ASSERT(before < _nodes.size() && after < _nodes.size());
+    _nodes[before]->_successors.push_back(_nodes[after].get());
+    ++_nodes[after]->_predecessors;
+    _roots.clear();
+  }
+
+  [[nodiscard]] std::size_t Size() const noexcept {
+    return _nodes.size();
+  }
+
+  /**
+   * Check if the future of the previous run is consumed or dropped, so the graph can be run or changed
+   *
+   * For example after Get, co_await or Cancel of the future, but not inside its Then callback.
+   */
+  [[nodiscard]] bool Idle() noexcept {
+    return !_core || _core->GetRef() == 0;
+  }
+
+  /**
+   * Run all nodes on executor
+   *
+   * The previous run should be \ref Idle, graph should be alive until then.
+   * \param e executor to be used to execute nodes
+   * \return \ref Future which is ready when all nodes are done or skipped
+   */
+  [[nodiscard]] Future<void, E> Run(IExecutor& e) {
+    YACLIB_ASSERT(Idle());
+    if (_roots.empty() && !_nodes.empty()) {
+      Prepare();
+    }
+    // The only reference is for the output future, so the graph is idle as soon as the future is consumed
+    _core.emplace(1);
+    Future<void, E> output{detail::UniqueCorePtr<void, E>{NoRefTag{}, &*_core}};
+    _executor = &e;
+    _failed.store(false, std::memory_order_relaxed);
+    _error = {};
+    _remaining.store(_nodes.size(), std::memory_order_relaxed);
+    if (_nodes.empty()) {
+      Complete();
+      return output;
+    }
+    if (!_acyclic) {
+      // Nodes of the cycle would never be ready, so the output would never be ready too
+      _error = Result<void, E>{std::make_exception_ptr(TaskGraphCycleError{})};
+      Complete();
+      return output;
+    }
+    detail::List roots;
+    for (auto& node : _nodes) {
+      node->_pending.store(node->_predecessors, std::memory_order_relaxed);
+    }
+    for (auto* root : _roots) {
+      roots.PushBack(*root);
+    }
+    e.SubmitBatch(roots, _roots.size());
+    return output;
+  }
+
+ private:
+  class Node : public Job {
+   public:
+    explicit Node(TaskGraph& graph) noexcept : _graph{graph} {
+    }
+
+    virtual void Invoke() = 0;
+
+    void Call() noexcept final {
+      _graph.Execute(*this);
+    }
+
+    void Drop() noexcept final {
+      _graph.Fail(StopTag{});
+      _graph.Execute(*this);
+    }
+
+    TaskGraph& _graph;
+    std::vector<Node*> _successors;
+    std::size_t _predecessors = 0;
+    yaclib_std::atomic_size_t _pending = 0;
+  };
+
+  template <typename Func>
+  class FuncNode final : public Node {
+   public:
+    template <typename Arg>
+    FuncNode(TaskGraph& graph, Arg&& f) : Node{graph}, _func{std::forward<Arg>(f)} {
+    }
+
+    void Invoke() final {
+      _func();
+    }
+
+   private:
+    Func _func;
+  };
+
+  // Find nodes without predecessors and check that every node is reachable from them, i.e. there are no cycles
+  void Prepare() {
+    for (auto& node : _nodes) {
+      node->_pending.store(node->_predecessors, std::memory_order_relaxed);
+      if (node->_predecessors == 0) {
+        _roots.push_back(node.get());
+      }
+    }
+    std::vector<Node*> order{_roots};
+    order.reserve(_nodes.size());
+    for (std::size_t i = 0; i != order.size(); ++i) {
+      for (auto* successor : order[i]->_successors) {
+        if (successor->_pending.fetch_sub(1, std::memory_order_relaxed) == 1) {
+          order.push_back(successor);
+        }
+      }
+    }
+    _acyclic = order.size() == _nodes.size();
+  }
+
+  void Execute(Node& node) noexcept {
+    auto* current = &node;
+    do {
+      if (!Stopped()) {
+        try {
+          current->Invoke();
+        } catch (...) {
+          Fail(std::current_exception());
+        }
+      }
+      Node* next = nullptr;
+      for (auto* successor : current->_successors) {
+        if (successor->_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+          if (next != nullptr) {
+            _executor->Submit(*next);
+          }
+          next = successor;
+        }
+      }
+      // If next isn't null, it isn't done yet, so this isn't the last node and graph is still alive
+      Done();
+      current = next;
+    } while (current != nullptr);
+  }
+
+  // Nothing is needed after the first error or when the output future is cancelled
+  bool Stopped() noexcept {
+    if (_failed.load(std::memory_order_relaxed)) {
+      return true;
+    }
+    if (_core->StopRequested()) {
+      Fail(StopTag{});
+      return true;
+    }
+    return false;
+  }
+
+  template <typename Error>
+  void Fail(Error&& error) noexcept {
+    if (!_failed.exchange(true, std::memory_order_acq_rel)) {
+      _error = Result<void, E>{std::forward<Error>(error)};
+    }
+  }
+
+  void Done() noexcept {
+    if (_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      Complete();
+    }
+  }
+
+  // The graph can be run again from the continuation, so nothing is touched after Set
+  void Complete() noexcept {
+    Promise<void, E> promise{detail::UniqueCorePtr<void, E>{NoRefTag{}, &*_core}};
+    if (_error.State() != ResultState::Empty) {
+      std::move(promise).Set(std::move(_error));
+    } else {
+      std::move(promise).Set();
+    }
+  }
+
+  std::vector<std::unique_ptr<Node>> _nodes;
+  std::vector<Node*> _roots;
+  bool _acyclic = true;
+  IExecutor* _executor = nullptr;
+  yaclib_std::atomic_size_t _remaining = 0;
+  yaclib_std::atomic_bool _failed = false;
+  Result<void, E> _error;
+  std::optional<detail::GraphCore<E>> _core;
+};
+
+}  // namespace yaclib
@@ -8,6 +8,9 @@
 #include <yaclib/util/result.hpp>
 #include <yaclib/util/type_traits.hpp>
 
+#include <cstddef>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace yaclib::when {
@@ -93,4 +96,57 @@ struct All<FailPolicy::FirstFail, OutputValue, OutputError, InputCore> {
   PromiseType _p;
 };
 
+/**
+ * Writes results to out[index] as soon as they're ready, so it doesn't store the cores and the output vector
+ *
+ * The output is ready only when all results are written, so the caller can read out after it.
+ * With FirstFail the output is the first error, and stop is requested for the rest of the inputs.
+ */
+template <typename Out, FailPolicy F, typename OutputValue, typename OutputError, typename InputCore>
+struct AllInto {
+  static_assert(F != FailPolicy::LastFail, "LastFail policy is not supported by AllInto");
+  static_assert(std::is_void_v<OutputValue>, "OutputValue should be void for AllInto");
+
+  using PromiseType = Promise<void, OutputError>;
+
+  static constexpr ConsumePolicy kConsumePolicy = ConsumePolicy::Dynamic;
+  static constexpr CorePolicy kCorePolicy = CorePolicy::Managed;
+
+  AllInto(std::size_t /*count*/, PromiseType p, Out out) : _p{std::move(p)}, _out{std::move(out)} {
+  }
+
+  [[nodiscard]] bool StopRequested() const noexcept {
+    return _done.load(std::memory_order_acquire);
+  }
+
+  template <typename Result>
+  void Consume(std::size_t index, Result&& result) {
+    if constexpr (F == FailPolicy::None) {
+      _out[index] = std::forward<Result>(result);
+    } else if (result) {
+      _out[index] = std::forward<Result>(result).Value();
+    } else if (!_done.load(std::memory_order_relaxed) && !_done.exchange(true, std::memory_order_acq_rel)) {
+      if (result.State() == ResultState::Error) {
+        _error = std::forward<Result>(result).Error();
+      } else {
+        _error = std::forward<Result>(result).Exception();
+      }
+    }
+  }
+
+  ~AllInto() {
+    if (_error.State() == ResultState::Empty) {
+      std::move(_p).Set();
+    } else {
+      std::move(_p).Set(std::move(_error));
+    }
+  }
+
+ private:
+  yaclib_std::atomic_bool _done = false;
+  Result<void, OutputError> _error;
+  PromiseType _p;
+  Out _out;
+};
+
 }  // namespace yaclib::when
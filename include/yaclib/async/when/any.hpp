@@ -22,6 +22,10 @@ struct Any<FailPolicy::None, OutputValue, OutputError, InputCore> {
   Any(std::size_t count, PromiseType p) : _p{std::move(p)} {
   }
 
+  [[nodiscard]] bool Done() const noexcept {
+    return _done.load(std::memory_order_acquire);
+  }
+
   template <typename Result>
   void Consume(Result&& result) {
     if (!_done.load(std::memory_order_relaxed) && !_done.exchange(true, std::memory_order_acq_rel)) {
@@ -49,6 +53,10 @@ struct Any<FailPolicy::FirstFail, OutputValue, OutputError, InputCore> {
   Any(std::size_t count, PromiseType p) : _p{std::move(p)} {
   }
 
+  [[nodiscard]] bool Done() const noexcept {
+    return _state.load(std::memory_order_acquire) == State::kValue;
+  }
+
   template <typename Result>
   void Consume(Result&& result) {
     if (result) {
@@ -101,6 +109,10 @@ struct Any<FailPolicy::LastFail, OutputValue, OutputError, InputCore> {
   Any(std::size_t count, PromiseType p) : _state{2 * count}, _p{std::move(p)} {
   }
 
+  [[nodiscard]] bool Done() const noexcept {
+    return DoneImpl(_state.load(std::memory_order_acquire));
+  }
+
   template <typename Result>
   void Consume(Result&& result) {
     if (!DoneImpl(_state.load(std::memory_order_acquire))) {
@@ -127,4 +139,17 @@ struct Any<FailPolicy::LastFail, OutputValue, OutputError, InputCore> {
   PromiseType _p;
 };
 
+/**
+ * Same as Any, but after the winner is chosen the other inputs are asked to stop,
+ * so their not started callbacks are skipped
+ */
+template <FailPolicy F, typename OutputValue, typename OutputError, typename InputCore>
+struct AnyCancel : Any<F, OutputValue, OutputError, InputCore> {
+  using Any<F, OutputValue, OutputError, InputCore>::Any;
+
+  [[nodiscard]] bool StopRequested() const noexcept {
+    return this->Done();
+  }
+};
+
 }  // namespace yaclib::when
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <yaclib/async/promise.hpp>
+#include <yaclib/async/when/when.hpp>
+#include <yaclib/util/combinator_strategy.hpp>
+#include <yaclib/util/fail_policy.hpp>
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace yaclib::when {
+
+/**
+ * Passes every result with its index to the Func as soon as it's ready, and completes when all inputs are consumed
+ *
+ * Nothing is stored, so Func can be called concurrently from the threads which complete the inputs.
+ * If Func has StopRequested(), it's also used as the stop request for the inputs.
+ */
+template <typename Func, FailPolicy F, typename OutputValue, typename OutputError, typename InputCore>
+struct Each {
+  static_assert(F == FailPolicy::None, "Each doesn't fail, it passes errors to the Func");
+  static_assert(std::is_void_v<OutputValue>, "OutputValue should be void for Each");
+
+  using PromiseType = Promise<void, OutputError>;
+
+  static constexpr ConsumePolicy kConsumePolicy = ConsumePolicy::Dynamic;
+  static constexpr CorePolicy kCorePolicy = CorePolicy::Managed;
+
+  template <typename Arg>
+  Each(std::size_t /*count*/, PromiseType p, Arg&& func) : _p{std::move(p)}, _func{std::forward<Arg>(func)} {
+  }
+
+  [[nodiscard]] bool StopRequested() const noexcept {
+    if constexpr (kHasStop<Func>) {
+      return _func.StopRequested();
+    } else {
+      return false;
+    }
+  }
+
+  template <typename Result>
+  void Consume(std::size_t index, Result&& result) noexcept {
+    _func(index, std::forward<Result>(result));
+  }
+
+  ~Each() {
+    std::move(_p).Set();
+  }
+
+ private:
+  PromiseType _p;
+  Func _func;
+};
+
+}  // namespace yaclib::when
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <yaclib/async/promise.hpp>
+#include <yaclib/util/combinator_strategy.hpp>
+#include <yaclib/util/detail/spinlock.hpp>
+#include <yaclib/util/fail_policy.hpp>
+#include <yaclib/util/result.hpp>
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <yaclib_std/atomic>
+#include <yaclib_std/thread>
+
+namespace yaclib::when {
+
+/**
+ * Folds values in the order of completion, so Op should be associative, commutative and noexcept
+ *
+ * Values are folded into a few partial accumulators, the thread starts from the one chosen by its id,
+ * so concurrent inputs rarely contend. Partial accumulators are folded together when all inputs are consumed.
+ * Memory doesn't depend on the count of inputs.
+ */
+template <typename Op, FailPolicy F, typename OutputValue, typename OutputError, typename InputCore>
+struct Reduce {
+  static_assert(F == FailPolicy::FirstFail, "Only FirstFail policy is supported by Reduce");
+  static_assert(!std::is_void_v<OutputValue>, "OutputValue shouldn't be void for Reduce");
+
+  using PromiseType = Promise<OutputValue, OutputError>;
+
+  static constexpr ConsumePolicy kConsumePolicy = ConsumePolicy::Unordered;
+  static constexpr CorePolicy kCorePolicy = CorePolicy::Managed;
+
+  static constexpr std::size_t kSlots = 8;
+
+  template <typename Arg>
+  Reduce(std::size_t /*count*/, PromiseType p, OutputValue identity, Arg&& op)
+    : _p{std::move(p)}, _identity{std::move(identity)}, _op{std::forward<Arg>(op)} {
+  }
+
+  [[nodiscard]] bool StopRequested() const noexcept {
+    return _done.load(std::memory_order_acquire);
+  }
+
+  template <typename Result>
+  void Consume(Result&& result) {
+    if (_done.load(std::memory_order_relaxed)) {
+      return;
+    }
+    if (!result) {
+      if (!_done.exchange(true, std::memory_order_acq_rel)) {
+        if (result.State() == ResultState::Error) {
+          std::move(_p).Set(std::forward<Result>(result).Error());
+        } else {
+          std::move(_p).Set(std::forward<Result>(result).Exception());
+        }
+      }
+      return;
+    }
+    auto& slot = Lock();
+    if (slot.acc) {
+      *slot.acc = _op(std::move(*slot.acc), std::forward<Result>(result).Value());
+    } else {
+      slot.acc.emplace(_op(OutputValue{_identity}, std::forward<Result>(result).Value()));
+    }
+    slot.lock.unlock();
+  }
+
+  ~Reduce() {
+    if (_p.Valid()) {
+      auto output = std::move(_identity);
+      for (auto& slot : _slots) {
+        if (slot.acc) {
+          output = _op(std::move(output), std::move(*slot.acc));
+        }
+      }
+      std::move(_p).Set(std::move(output));
+    }
+  }
+
+ private:
+  struct alignas(64) Slot {
+    detail::Spinlock<bool> lock;
+    std::optional<OutputValue> acc;
+  };
+
+  Slot& Lock() noexcept {
+    using Id = std::decay_t<decltype(yaclib_std::this_thread::get_id())>;
+    const auto home = std::hash<Id>{}(yaclib_std::this_thread::get_id()) % kSlots;
+    for (std::size_t i = 0; i != kSlots; ++i) {
+      auto& slot = _slots[(home + i) % kSlots];
+      if (slot.lock.try_lock()) {
+        return slot;
+      }
+    }
+    auto& slot = _slots[home];
+    slot.lock.lock();
+    return slot;
+  }
+
+  std::array<Slot, kSlots> _slots;
+  yaclib_std::atomic_bool _done = false;
+  PromiseType _p;
+  OutputValue _identity;
+  Op _op;
+};
+
+}  // namespace yaclib::when
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <yaclib/async/promise.hpp>
+#include <yaclib/util/combinator_strategy.hpp>
+#include <yaclib/util/fail_policy.hpp>
+#include <yaclib/util/result.hpp>
+#include <yaclib/util/type_traits.hpp>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include <yaclib_std/atomic>
+
+namespace yaclib::when {
+
+template <FailPolicy F, typename OutputValue, typename OutputError, typename InputCore>
+struct Some {
+  static_assert(F == FailPolicy::LastFail, "Only LastFail policy is supported by Some");
+};
+
+/**
+ * Waits for the first k values, or fails with the error after which k values can't be collected anymore
+ *
+ * Keeps only the cores of the winners, every other input is released as soon as it's consumed.
+ */
+template <typename OutputValue, typename OutputError, typename InputCore>
+struct Some<FailPolicy::LastFail, OutputValue, OutputError, InputCore> {
+  using PromiseType = Promise<OutputValue, OutputError>;
+
+  static constexpr ConsumePolicy kConsumePolicy = ConsumePolicy::Dynamic;
+  static constexpr CorePolicy kCorePolicy = CorePolicy::Owned;
+
+  Some(std::size_t count, PromiseType p, std::size_t k) : _p{std::move(p)}, _fails{count - k + 1} {
+    if (k == 0) {
+      _done.store(true, std::memory_order_relaxed);
+      std::move(_p).Set(OutputValue{});
+    } else if (k > count) {
+      _done.store(true, std::memory_order_relaxed);
+      std::move(_p).Set(StopTag{});
+    } else {
+      _winners.resize(k);
+    }
+  }
+
+  // If the quorum failed, values which already arrived are never retired
+  ~Some() {
+    for (auto [index, core] : _winners) {
+      if (core != nullptr) {
+        core->DecRef();
+      }
+    }
+  }
+
+  void Register(std::size_t /*i*/, InputCore& /*core*/) noexcept {
+  }
+
+  [[nodiscard]] bool StopRequested() const noexcept {
+    return _done.load(std::memory_order_acquire);
+  }
+
+  void Consume(std::size_t index, InputCore& core) {
+    auto& result = core.Get();
+    if (result) {
+      const auto slot = _values.fetch_add(1, std::memory_order_relaxed);
+      if (slot < _winners.size()) {
+        _winners[slot] = {index, &core};
+        if (_stored.fetch_add(1, std::memory_order_acq_rel) + 1 == _winners.size()) {
+          Complete();
+        }
+        return;
+      }
+    } else if (_failed.fetch_add(1, std::memory_order_acq_rel) + 1 == _fails &&
+               !_done.load(std::memory_order_relaxed)) {
+      _done.store(true, std::memory_order_release);
+      if (result.State() == ResultState::Exception) {
+        std::move(_p).Set(std::as_const(result).Exception());
+      } else {
+        std::move(_p).Set(std::as_const(result).Error());
+      }
+    }
+    core.DecRef();
+  }
+
+ private:
+  void Complete() {
+    _done.store(true, std::memory_order_release);
+    OutputValue output;
+    output.reserve(_winners.size());
+    for (auto& [index, core] : _winners) {
+      output.emplace_back(index, std::exchange(core, nullptr)->Retire().Value());
+    }
+    std::move(_p).Set(std::move(output));
+  }
+
+  std::vector<std::pair<std::size_t, InputCore*>> _winners;
+  yaclib_std::atomic_size_t _values = 0;
+  yaclib_std::atomic_size_t _stored = 0;
+  yaclib_std::atomic_size_t _failed = 0;
+  yaclib_std::atomic_bool _done = false;
+  PromiseType _p;
+  std::size_t _fails;
+};
+
+}  // namespace yaclib::when
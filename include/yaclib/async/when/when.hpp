@@ -11,7 +11,10 @@
 #include <yaclib/util/ref.hpp>
 #include <yaclib/util/type_traits.hpp>
 
+#include <array>
 #include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace yaclib::when {
@@ -35,6 +38,40 @@ inline constexpr bool kIsOrdered = P == ConsumePolicy::Static || P == ConsumePol
 
 inline constexpr std::size_t kDynamicTag = std::numeric_limits<std::size_t>::max();
 
+/**
+ * Binds the first template argument of the strategy, for example a functor type,
+ * because combinator strategy is parametrized only by FailPolicy and types of output and input
+ */
+template <template <typename, FailPolicy, typename...> typename Strategy, typename Arg>
+struct Bind {
+  template <FailPolicy F, typename... Args>
+  struct Type : Strategy<Arg, F, Args...> {
+    using Base = Strategy<Arg, F, Args...>;
+    using Base::Base;
+  };
+};
+
+template <typename Strategy, typename = void>
+inline constexpr bool kHasStop = false;
+
+template <typename Strategy>
+inline constexpr bool kHasStop<Strategy, std::void_t<decltype(std::declval<const Strategy&>().StopRequested())>> =
+  true;
+
+// Inputs ask the combinator only if it can request stop
+template <typename Strategy>
+inline constexpr auto kStop = kHasStop<Strategy> ? detail::BaseCore::kAskStop : detail::BaseCore::kNoStop;
+
+template <typename Strategy>
+YACLIB_INLINE const detail::InlineCore* StopNext(const Strategy& st, bool& stop) noexcept {
+  if constexpr (kHasStop<Strategy>) {
+    stop = st.StopRequested();
+  } else {
+    stop = false;
+  }
+  return nullptr;
+}
+
 template <typename Strategy, typename Core>
 YACLIB_INLINE void ConsumeImpl(Strategy& st, Core& core) {
   if constexpr (Strategy::kCorePolicy == CorePolicy::Owned) {
@@ -109,6 +146,10 @@ struct CombinatorCallback final : detail::InlineCore {
   }
 #endif
 
+  [[nodiscard]] const InlineCore* StopNext(bool& stop) const noexcept final {
+    return when::StopNext(_self->st, stop);
+  }
+
  private:
   YACLIB_INLINE void Impl(InlineCore& caller) {
     auto& core = DownCast<Core>(caller);
@@ -136,7 +177,9 @@ struct CoreSignature {
 
 template <typename Strategy, typename Core>
 struct SingleCombinator : detail::InlineCore {
-  SingleCombinator(std::size_t count, typename Strategy::PromiseType p) : st{count, std::move(p)} {
+  template <typename... Args>
+  SingleCombinator(std::size_t count, typename Strategy::PromiseType p, Args&&... args)
+    : st{count, std::move(p), std::forward<Args>(args)...} {
   }
 
   // Static case Set
@@ -157,7 +200,7 @@ struct SingleCombinator : detail::InlineCore {
         st.Register(i, core);
       }
 
-      if (!core.SetCallback(*this)) {
+      if (!core.SetCallback(*this, kStop<Strategy>)) {
         Consume(st, core, i);
         DecRef();
       }
@@ -178,13 +221,17 @@ struct SingleCombinator : detail::InlineCore {
   }
 #endif
 
+  [[nodiscard]] const InlineCore* StopNext(bool& stop) const noexcept final {
+    return when::StopNext(st, stop);
+  }
+
  private:
   void SetCore(Core& core, std::size_t i) {
     if constexpr (Strategy::kCorePolicy == CorePolicy::Owned) {
       st.Register(i, core);
     }
 
-    if (!core.SetCallback(*this)) {
+    if (!core.SetCallback(*this, kStop<Strategy>)) {
       Consume<0>(st, core);
       DecRef();
     }
@@ -256,7 +303,7 @@ struct StaticCombinator : IRef {
       st.Register(Index, core);
     }
 
-    if (!core.SetCallback(callback)) {
+    if (!core.SetCallback(callback, kStop<Strategy>)) {
       Consume<Index>(st, core);
       DecRef();
     }
@@ -285,10 +332,20 @@ struct StaticCombinator : IRef {
   Callbacks callbacks;
 };
 
-template <typename Strategy, typename Core>
+// N is the count of inputs, if it's known at compile time, then the callbacks are stored inline
+template <typename Strategy, typename Core, std::size_t N = kDynamicTag>
 struct DynamicCombinator : IRef {
-  DynamicCombinator(std::size_t count, typename Strategy::PromiseType p)
-    : st{count, std::move(p)}, callbacks{count, {this}} {
+  using Callback = CombinatorCallback<DynamicCombinator, Core, kDynamicTag>;
+  using Callbacks = std::conditional_t<N == kDynamicTag, std::vector<Callback>, std::array<Callback, N>>;
+
+  template <typename... Args>
+  DynamicCombinator(std::size_t count, typename Strategy::PromiseType p, Args&&... args)
+    : st{count, std::move(p), std::forward<Args>(args)...} {
+    if constexpr (N == kDynamicTag) {
+      callbacks.assign(count, {this});
+    } else {
+      callbacks.fill({this});
+    }
   }
 
   template <typename Iterator>
@@ -300,7 +357,7 @@ struct DynamicCombinator : IRef {
         st.Register(i, core);
       }
 
-      if (!core.SetCallback(callbacks[i])) {
+      if (!core.SetCallback(callbacks[i], kStop<Strategy>)) {
         Consume(st, core, i);
         DecRef();
       }
@@ -310,7 +367,7 @@ struct DynamicCombinator : IRef {
   }
 
   Strategy st;
-  std::vector<CombinatorCallback<DynamicCombinator, Core, kDynamicTag>> callbacks;
+  Callbacks callbacks;
 };
 
 template <template <FailPolicy, typename...> typename Strategy, FailPolicy F, typename OutputValue,
@@ -345,8 +402,9 @@ auto When(Futures... futures) {
 }
 
 template <template <FailPolicy, typename...> typename Strategy, FailPolicy F, typename OutputValue,
-          typename OutputError, typename Iterator, typename Value = typename std::iterator_traits<Iterator>::value_type>
-auto When(Iterator begin, std::size_t count) {
+          typename OutputError, typename Iterator, typename Value = typename std::iterator_traits<Iterator>::value_type,
+          typename... Args>
+auto When(Iterator begin, std::size_t count, Args&&... args) {
   if (count == 0) {
     return Future<OutputValue, OutputError>{nullptr};
   }
@@ -361,9 +419,32 @@ auto When(Iterator begin, std::size_t count) {
   using FinalCombinator = std::conditional_t<!kIsOrdered<S::kConsumePolicy> && IsUniqueCore<Core>::Value,
                                              SingleCombinator<S, Core>, DynamicCombinator<S, Core>>;
 
-  auto* combinator = MakeShared<FinalCombinator>(count, count, std::move(p)).Release();
+  auto* combinator = MakeShared<FinalCombinator>(count, count, std::move(p), std::forward<Args>(args)...).Release();
   combinator->Set(begin, count);
   return std::move(f);
 }
 
+// Same as When(begin, count), but count is known at compile time, so the combinator is the only allocation
+template <template <FailPolicy, typename...> typename Strategy, FailPolicy F, typename OutputValue,
+          typename OutputError, std::size_t N, typename Iterator,
+          typename Value = typename std::iterator_traits<Iterator>::value_type, typename... Args>
+auto When(Iterator begin, Args&&... args) {
+  if constexpr (N == 0) {
+    return Future<OutputValue, OutputError>{nullptr};
+  } else {
+    auto [f, p] = MakeContract<OutputValue, OutputError>();
+
+    using Core = typename Value::Core;
+    using S = Strategy<F, OutputValue, OutputError, Core>;
+
+    static_assert(S::kConsumePolicy == ConsumePolicy::Dynamic);
+
+    using FinalCombinator = DynamicCombinator<S, Core, N>;
+
+    auto* combinator = MakeShared<FinalCombinator>(N, N, std::move(p), std::forward<Args>(args)...).Release();
+    combinator->Set(begin, N);
+    return std::move(f);
+  }
+}
+
 }  // namespace yaclib::when
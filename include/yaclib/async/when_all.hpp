@@ -9,6 +9,10 @@
 #include <yaclib/util/fail_policy.hpp>
 #include <yaclib/util/type_traits.hpp>
 
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
 namespace yaclib {
 
 template <typename Core, FailPolicy F>
@@ -56,4 +60,27 @@ YACLIB_INLINE auto WhenAll(It begin, It end) {
   return WhenAll<F>(begin, static_cast<std::size_t>(end - begin));
 }
 
+/**
+ * Same as \ref WhenAll, but the results are written to out[i] as soon as they're ready
+ *
+ * For the fixed size batch the combinator is the only allocation, there are no vectors at all.
+ * \param out storage for the results, it should outlive the output future completion
+ * \return Future<void> which is ready when all results are written, with FirstFail it's the first error
+ */
+template <FailPolicy F = FailPolicy::FirstFail, typename It, typename Elem, std::size_t N,
+          typename T = typename std::iterator_traits<It>::value_type>
+YACLIB_INLINE auto WhenAll(It begin, std::array<Elem, N>& out) {
+  static_assert(std::is_same_v<Elem, ContainerElem<typename T::Core, F>>, "Wrong type of the storage");
+  using Strategy = when::Bind<when::AllInto, Elem*>;
+  return when::When<Strategy::template Type, F, void, typename T::Core::Error, N>(begin, out.data());
+}
+
+template <FailPolicy F = FailPolicy::FirstFail, typename It, typename Elem,
+          typename T = typename std::iterator_traits<It>::value_type>
+YACLIB_INLINE auto WhenAll(It begin, std::size_t count, Elem* out) {
+  static_assert(std::is_same_v<Elem, ContainerElem<typename T::Core, F>>, "Wrong type of the storage");
+  using Strategy = when::Bind<when::AllInto, Elem*>;
+  return when::When<Strategy::template Type, F, void, typename T::Core::Error>(begin, count, out);
+}
+
 }  // namespace yaclib
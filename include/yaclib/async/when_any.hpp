@@ -3,24 +3,30 @@
 #include <yaclib/async/when/any.hpp>
 #include <yaclib/async/when/when.hpp>
 #include <yaclib/config.hpp>
+#include <yaclib/lazy/task.hpp>
 #include <yaclib/util/fail_policy.hpp>
 #include <yaclib/util/type_traits.hpp>
 
+#include <array>
+#include <cstddef>
+#include <vector>
+
 namespace yaclib {
+namespace detail {
 
-template <FailPolicy F = FailPolicy::LastFail, typename... Futures,
-          typename = std::enable_if_t<(... && is_combinator_input_v<Futures>)>>
-YACLIB_INLINE auto WhenAny(Futures... futures) {
+template <template <FailPolicy, typename...> typename Strategy, FailPolicy F, typename... Futures>
+YACLIB_INLINE auto WhenAnyImpl(Futures... futures) {
   when::CheckSameError<Futures...>();
 
   using OutputValue = typename MaybeVariant<typename Unique<std::tuple<typename Futures::Core::Value...>>::Type>::Type;
   using OutputError = typename head_t<Futures...>::Core::Error;
 
-  return when::When<when::Any, F, OutputValue, OutputError>(std::move(futures)...);
+  return when::When<Strategy, F, OutputValue, OutputError>(std::move(futures)...);
 }
 
-template <FailPolicy F = FailPolicy::LastFail, typename It, typename T = typename std::iterator_traits<It>::value_type>
-YACLIB_INLINE auto WhenAny(It begin, std::size_t count) {
+template <template <FailPolicy, typename...> typename Strategy, FailPolicy F, typename It,
+          typename T = typename std::iterator_traits<It>::value_type>
+YACLIB_INLINE auto WhenAnyImpl(It begin, std::size_t count) {
   if constexpr (is_future_base_v<T>) {
     if (count == 1) {
       using V = async_value_t<T>;
@@ -29,7 +35,20 @@ YACLIB_INLINE auto WhenAny(It begin, std::size_t count) {
     }
   }
 
-  return when::When<when::Any, F, typename T::Core::Value, typename T::Core::Error>(begin, count);
+  return when::When<Strategy, F, typename T::Core::Value, typename T::Core::Error>(begin, count);
+}
+
+}  // namespace detail
+
+template <FailPolicy F = FailPolicy::LastFail, typename... Futures,
+          typename = std::enable_if_t<(... && is_combinator_input_v<Futures>)>>
+YACLIB_INLINE auto WhenAny(Futures... futures) {
+  return detail::WhenAnyImpl<when::Any, F>(std::move(futures)...);
+}
+
+template <FailPolicy F = FailPolicy::LastFail, typename It, typename T = typename std::iterator_traits<It>::value_type>
+YACLIB_INLINE auto WhenAny(It begin, std::size_t count) {
+  return detail::WhenAnyImpl<when::Any, F>(begin, count);
 }
 
 template <FailPolicy F = FailPolicy::LastFail, typename It, typename T = typename std::iterator_traits<It>::value_type>
@@ -39,4 +58,51 @@ YACLIB_INLINE auto WhenAny(It begin, It end) {
   return WhenAny<F>(begin, static_cast<std::size_t>(end - begin));
 }
 
+/**
+ * Same as \ref WhenAny, but when the winner is chosen the other inputs are asked to stop
+ *
+ * Not started callbacks of the losers are skipped, their promises can check \ref Promise::StopRequested.
+ * \ref Task inputs are started only after the combinator is ready, so the tasks started after the winner never run.
+ */
+template <FailPolicy F = FailPolicy::LastFail, typename... Futures,
+          typename = std::enable_if_t<(... && is_combinator_input_v<Futures>)>>
+YACLIB_INLINE auto WhenAnyCancel(Futures... futures) {
+  return detail::WhenAnyImpl<when::AnyCancel, F>(std::move(futures)...);
+}
+
+template <FailPolicy F = FailPolicy::LastFail, typename... Tasks,
+          typename = std::enable_if_t<(... && is_task_v<Tasks>)>, typename = void>
+auto WhenAnyCancel(Tasks... tasks) {
+  std::array<detail::BaseCore*, sizeof...(Tasks)> cores{tasks.GetCore().Get()...};
+  auto f = detail::WhenAnyImpl<when::AnyCancel, F>(std::move(tasks)...);
+  for (auto* core : cores) {
+    detail::Start(core);
+  }
+  return f;
+}
+
+template <FailPolicy F = FailPolicy::LastFail, typename It, typename T = typename std::iterator_traits<It>::value_type>
+auto WhenAnyCancel(It begin, std::size_t count) {
+  if constexpr (is_task_v<T>) {
+    std::vector<detail::BaseCore*> cores;
+    cores.reserve(count);
+    auto it = begin;
+    for (std::size_t i = 0; i != count; ++i, ++it) {
+      cores.push_back(it->GetCore().Get());
+    }
+    auto f = when::When<when::AnyCancel, F, typename T::Core::Value, typename T::Core::Error>(begin, count);
+    for (auto* core : cores) {
+      detail::Start(core);
+    }
+    return f;
+  } else {
+    return detail::WhenAnyImpl<when::AnyCancel, F>(begin, count);
+  }
+}
+
+template <FailPolicy F = FailPolicy::LastFail, typename It, typename T = typename std::iterator_traits<It>::value_type>
+YACLIB_INLINE auto WhenAnyCancel(It begin, It end) {
+  return WhenAnyCancel<F>(begin, static_cast<std::size_t>(end - begin));
+}
+
 }  // namespace yaclib
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <yaclib/async/when/each.hpp>
+#include <yaclib/async/when/when.hpp>
+#include <yaclib/config.hpp>
+#include <yaclib/util/fail_policy.hpp>
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace yaclib {
+
+/**
+ * Call func(index, result) for every future as soon as it's ready
+ *
+ * Results aren't stored anywhere, the func can be called concurrently and shouldn't throw.
+ * \param begin, count range of futures
+ * \param func callback for the each result
+ * \return Future which is ready after all results are passed to the func
+ */
+template <typename It, typename Func, typename T = typename std::iterator_traits<It>::value_type>
+YACLIB_INLINE auto WhenEach(It begin, std::size_t count, Func&& func) {
+  using Strategy = when::Bind<when::Each, std::decay_t<Func>>;
+  return when::When<Strategy::template Type, FailPolicy::None, void, typename T::Core::Error>(begin, count,
+                                                                                              std::forward<Func>(func));
+}
+
+template <typename It, typename Func, typename T = typename std::iterator_traits<It>::value_type>
+YACLIB_INLINE auto WhenEach(It begin, It end, Func&& func) {
+  return WhenEach(begin, static_cast<std::size_t>(end - begin), std::forward<Func>(func));
+}
+
+}  // namespace yaclib
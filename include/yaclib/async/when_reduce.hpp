@@ -0,0 +1,50 @@
+#pragma once
+
+#include <yaclib/async/make.hpp>
+#include <yaclib/async/when/reduce.hpp>
+#include <yaclib/async/when/when.hpp>
+#include <yaclib/config.hpp>
+#include <yaclib/util/fail_policy.hpp>
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace yaclib {
+
+/**
+ * Create \ref Future with op(...op(op(identity, v1), v2)..., vn), where values are folded as soon as they're ready
+ *
+ * Values are folded in the order of completion, so op should be associative and commutative.
+ * Commutativity is the price of not storing values: folding in the order of inputs would need to keep every value
+ * which is ready before its predecessors.
+ * The first error completes the output and requests stop for the rest of the futures.
+ * \param begin, count range of futures to reduce
+ * \param identity identity element of op, it can be folded more than once, also the output for the empty range
+ * \param op noexcept binary operation, op(T, Value) and op(T, T) should return T
+ */
+template <FailPolicy F = FailPolicy::FirstFail, typename It, typename T, typename Op,
+          typename Input = typename std::iterator_traits<It>::value_type>
+auto WhenReduce(It begin, std::size_t count, T&& identity, Op&& op) {
+  using OutputValue = std::decay_t<T>;
+  using OutputError = typename Input::Core::Error;
+  using InputValue = typename Input::Core::Value;
+  // Op runs under the spinlock of the partial accumulator, in the noexcept path of the input completion
+  static_assert(std::is_nothrow_invocable_r_v<OutputValue, std::decay_t<Op>&, OutputValue&&, InputValue&&> &&
+                  std::is_nothrow_invocable_r_v<OutputValue, std::decay_t<Op>&, OutputValue&&, OutputValue&&>,
+                "op should be noexcept");
+  if (count == 0) {
+    return MakeFuture<OutputValue, OutputError>(std::forward<T>(identity));
+  }
+  using Strategy = when::Bind<when::Reduce, std::decay_t<Op>>;
+  return when::When<Strategy::template Type, F, OutputValue, OutputError>(begin, count, std::forward<T>(identity),
+                                                                         std::forward<Op>(op));
+}
+
+template <FailPolicy F = FailPolicy::FirstFail, typename It, typename T, typename Op,
+          typename Input = typename std::iterator_traits<It>::value_type>
+YACLIB_INLINE auto WhenReduce(It begin, It end, T&& identity, Op&& op) {
+  return WhenReduce<F>(begin, static_cast<std::size_t>(end - begin), std::forward<T>(identity), std::forward<Op>(op));
+}
+
+}  // namespace yaclib
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <yaclib/async/make.hpp>
+#include <yaclib/async/when/some.hpp>
+#include <yaclib/async/when/when.hpp>
+#include <yaclib/config.hpp>
+#include <yaclib/util/fail_policy.hpp>
+#include <yaclib/util/type_traits.hpp>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace yaclib {
+
+/**
+ * Create \ref Future which is ready when k of the futures have values
+ *
+ * The output is k pairs of the input index and the value, in the order of completion.
+ * If so many inputs failed that k values can't be collected anymore, the output fails with the last error.
+ * After the output is completed, the remaining inputs are asked to stop, see \ref Future::Cancel.
+ * Empty range gives the ready output: empty for k == 0, and StopError otherwise.
+ * \param k how many values are needed
+ * \param begin, count range of futures to combine
+ */
+template <FailPolicy F = FailPolicy::LastFail, typename It, typename T = typename std::iterator_traits<It>::value_type>
+YACLIB_INLINE auto WhenSome(std::size_t k, It begin, std::size_t count) {
+  using Value = typename T::Core::Value;
+  using Error = typename T::Core::Error;
+  using OutputValue = std::vector<std::pair<std::size_t, wrap_void_t<Value>>>;
+  if (count == 0) {
+    // When returns an invalid future for the empty range, but the output is known here
+    if (k == 0) {
+      return MakeFuture<OutputValue, Error>(OutputValue{});
+    }
+    return MakeFuture<OutputValue, Error>(StopTag{});
+  }
+  return when::When<when::Some, F, OutputValue, Error>(begin, count, k);
+}
+
+template <FailPolicy F = FailPolicy::LastFail, typename It, typename T = typename std::iterator_traits<It>::value_type>
+YACLIB_INLINE auto WhenSome(std::size_t k, It begin, It end) {
+  return WhenSome<F>(k, begin, static_cast<std::size_t>(end - begin));
+}
+
+}  // namespace yaclib
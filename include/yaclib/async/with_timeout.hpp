@@ -0,0 +1,156 @@
+#pragma once
+
+#include <yaclib/algo/detail/inline_core.hpp>
+#include <yaclib/algo/detail/unique_core.hpp>
+#include <yaclib/async/future.hpp>
+#include <yaclib/async/promise.hpp>
+#include <yaclib/async/when/any.hpp>
+#include <yaclib/exe/inline.hpp>
+#include <yaclib/exe/job.hpp>
+#include <yaclib/runtime/timer_service.hpp>
+#include <yaclib/util/cast.hpp>
+#include <yaclib/util/fail_policy.hpp>
+#include <yaclib/util/helper.hpp>
+
+#include <chrono>
+#include <exception>
+#include <utility>
+
+namespace yaclib {
+
+/**
+ * Exception of the \ref WithDeadline output if the deadline expires first
+ */
+struct TimeoutError final : std::exception {
+  const char* what() const noexcept final {
+    return "yaclib::TimeoutError";
+  }
+};
+
+namespace detail {
+
+// All expired timeouts share one exception, so the expiration copies the pointer instead of the allocation
+inline const std::exception_ptr& TimeoutException() noexcept {
+  static const auto kTimeout = std::make_exception_ptr(TimeoutError{});
+  return kTimeout;
+}
+
+/**
+ * Result core of the WithTimeout, it's also the combinator for the input future and the timer
+ *
+ * References: one for the output future, one for the input callback and one for the armed timer.
+ */
+template <typename V, typename E>
+class TimeoutCore : public UniqueCore<V, E> {
+  using Strategy = when::Any<FailPolicy::None, V, E, UniqueCore<V, E>>;
+
+ public:
+  explicit TimeoutCore(TimerService& service)
+    : _service{service}, _st{1, Promise<V, E>{UniqueCorePtr<V, E>{NoRefTag{}, this}}}, _callback{this}, _timer{this} {
+  }
+
+  void Start(UniqueCore<V, E>& input, TimerService::Clock::time_point deadline) noexcept {
+    _service.Arm(_timer, _timer, MakeInline(), deadline);
+    input.CallInline(_callback, BaseCore::kAskStop);
+  }
+
+ private:
+  struct Callback final : InlineCore {
+    explicit Callback(TimeoutCore* self) noexcept : _self{self} {
+    }
+
+    [[nodiscard]] InlineCore* Here(InlineCore& caller) noexcept final {
+      Impl(caller);
+      return nullptr;
+    }
+
+#if YACLIB_SYMMETRIC_TRANSFER != 0
+    [[nodiscard]] yaclib_std::coroutine_handle<> Next(InlineCore& caller) noexcept final {
+      Impl(caller);
+      return yaclib_std::noop_coroutine();
+    }
+#endif
+
+    // Input isn't needed if the timer already won.
+    // We don't go to the output, because the timer can complete it and its callback can be destroyed meanwhile.
+    [[nodiscard]] const InlineCore* StopNext(bool& stop) const noexcept final {
+      stop = _self->_st._done.load(std::memory_order_acquire);
+      return nullptr;
+    }
+
+    YACLIB_INLINE void Impl(InlineCore& caller) noexcept {
+      _self->_st.Consume(DownCast<UniqueCore<V, E>>(caller).Retire());
+      // Timer is still armed, so it will never run and we release its reference here
+      if (_self->_service.Cancel(_self->_timer)) {
+        _self->DecRef();
+      }
+      _self->DecRef();
+    }
+
+    TimeoutCore* _self;
+  };
+
+  struct Timer final : Job, TimerNode {
+    explicit Timer(TimeoutCore* self) noexcept : _self{self} {
+    }
+
+    void Call() noexcept final {
+      Expire(TimeoutException());
+    }
+
+    // Stopped TimerService drops the timer, we complete with StopTag, otherwise the output could hang forever
+    void Drop() noexcept final {
+      Expire(StopTag{});
+    }
+
+    template <typename Error>
+    void Expire(Error&& error) noexcept {
+      _self->_st.Consume(Result<V, E>{std::forward<Error>(error)});
+      _self->DecRef();
+    }
+
+    TimeoutCore* _self;
+  };
+
+  TimerService& _service;
+  Strategy _st;
+  Callback _callback;
+  Timer _timer;
+};
+
+}  // namespace detail
+
+/**
+ * Complete with the result of the future or with \ref TimeoutError exception if the deadline expires first
+ *
+ * So the timeout is ResultState::Exception, while StopError still means the broken promise, \ref Future::Cancel
+ * or the stopped timer service, which drops the armed timer.
+ * When the future wins, the timer is disarmed immediately.
+ * Ready future is returned as is, otherwise it costs one allocation and no threads.
+ * \note Output is completed on the thread which completes the future, or on the timer service thread when the deadline
+ * expires, so inline continuations, for example from ThenInline, can run on the timer service thread and delay other
+ * timers. Attach continuations with an executor for anything but short work.
+ * \param timer service which should outlive the returned future completion
+ */
+template <typename V, typename E>
+[[nodiscard]] Future<V, E> WithDeadline(FutureBase<V, E>&& future, TimerService& timer,
+                                        TimerService::Clock::time_point deadline) {
+  YACLIB_ASSERT(future.Valid());
+  if (future.Ready()) {
+    return Future<V, E>{std::move(future.GetCore())};
+  }
+  auto& input = *future.GetCore().Release();
+  auto* core = MakeShared<detail::TimeoutCore<V, E>>(3, timer).Release();
+  Future<V, E> output{detail::UniqueCorePtr<V, E>{NoRefTag{}, core}};
+  core->Start(input, deadline);
+  return output;
+}
+
+template <typename V, typename E, typename Rep, typename Period>
+[[nodiscard]] Future<V, E> WithTimeout(FutureBase<V, E>&& future, TimerService& timer,
+                                       const std::chrono::duration<Rep, Period>& timeout) {
+  return WithDeadline(std::move(future), timer,
+                      TimerService::Clock::now() + std::chrono::ceil<TimerService::Clock::duration>(timeout));
+}
+
+}  // namespace yaclib
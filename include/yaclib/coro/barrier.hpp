@@ -0,0 +1,158 @@
+#pragma once
+
+#include <yaclib/algo/detail/base_core.hpp>
+#include <yaclib/coro/coro.hpp>
+#include <yaclib/coro/detail/resume.hpp>
+#include <yaclib/log.hpp>
+#include <yaclib/util/detail/intrusive_list.hpp>
+#include <yaclib/util/detail/spinlock.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+namespace yaclib {
+namespace detail {
+
+struct NopCompletion final {
+  constexpr void operator()() const noexcept {
+  }
+};
+
+template <typename Completion>
+class BarrierImpl {
+  static_assert(std::is_nothrow_invocable_v<Completion&>, "Completion should be noexcept");
+
+ public:
+  BarrierImpl(std::size_t count, Completion&& completion) noexcept(std::is_nothrow_move_constructible_v<Completion>)
+    : _expected{count}, _completion{std::move(completion)} {
+  }
+
+  ~BarrierImpl() {
+    YACLIB_ASSERT(_waiters.Empty());
+  }
+
+  void ArriveAndDrop() noexcept {
+    _lock.lock();
+    YACLIB_ASSERT(_expected != 0);
+    --_expected;
+    if (_arrived == _expected) {
+      return Complete();
+    }
+    _lock.unlock();
+  }
+
+  [[nodiscard]] std::size_t Phase() const noexcept {
+    std::lock_guard lock{_lock};
+    return _phase;
+  }
+
+  // Returns true if the coroutine should be suspended
+  [[nodiscard]] bool AwaitArrive(BaseCore& curr, std::size_t& phase) noexcept {
+    _lock.lock();
+    phase = _phase;
+    if (++_arrived == _expected) {
+      Complete();
+      return false;
+    }
+    _waiters.PushBack(curr);
+    _lock.unlock();
+    return true;
+  }
+
+ private:
+  // Unlocks the lock. Waiters of the phase can't arrive again until they are resumed, so nothing is changed
+  // until the completion is done, and it isn't called under the lock
+  void Complete() noexcept {
+    _arrived = 0;
+    ++_phase;
+    List waiters;
+    waiters.PushBack(std::move(_waiters));
+    _lock.unlock();
+    _completion();
+    ResumeBatch(waiters);
+  }
+
+  std::size_t _expected;
+  std::size_t _arrived = 0;
+  std::size_t _phase = 0;
+  List _waiters;
+  mutable Spinlock<std::uint32_t> _lock;
+  Completion _completion;
+};
+
+template <typename B>
+class [[nodiscard]] BarrierAwaiter final {
+ public:
+  explicit BarrierAwaiter(B& barrier) noexcept : _barrier{barrier} {
+  }
+
+  constexpr bool await_ready() const noexcept {
+    return false;
+  }
+
+  template <typename Promise>
+  YACLIB_INLINE bool await_suspend(yaclib_std::coroutine_handle<Promise> handle) noexcept {
+    return _barrier.AwaitArrive(handle.promise(), _phase);
+  }
+
+  [[nodiscard]] std::size_t await_resume() const noexcept {
+    return _phase;
+  }
+
+ private:
+  B& _barrier;
+  std::size_t _phase = 0;
+};
+
+}  // namespace detail
+
+/**
+ * Reusable barrier for coroutines
+ *
+ * Every phase is completed when count participants arrive. The last of them calls the completion inline
+ * and resumes the others, they are submitted to their executors by batches, and continues without suspension.
+ * Then the next phase starts, so the barrier can be used for rounds of work without any reset.
+ * \note It does not block execution thread, only coroutine
+ * \tparam Completion noexcept func without arguments, which is called when every phase is completed
+ */
+template <typename Completion = detail::NopCompletion>
+class AsyncBarrier final : protected detail::BarrierImpl<Completion> {
+ public:
+  using Base = detail::BarrierImpl<Completion>;
+
+  /**
+   * \param count participants of every phase
+   * \param completion called by the last participant of every phase, before the others are resumed
+   */
+  explicit AsyncBarrier(std::size_t count, Completion completion = {}) noexcept(
+    std::is_nothrow_move_constructible_v<Completion>)
+    : Base{count, std::move(completion)} {
+  }
+
+  /**
+   * Arrive at the current phase and suspend until it's completed
+   *
+   * \return Awaitable, which await_resume returns the number of the completed phase, starting from zero
+   */
+  auto ArriveAndWait() noexcept {
+    return detail::BarrierAwaiter<Base>{*this};
+  }
+
+  /**
+   * Arrive at the current phase and decrement participants count for the next phases
+   */
+  using Base::ArriveAndDrop;
+
+  /**
+   * Number of the current phase, starting from zero
+   */
+  using Base::Phase;
+};
+
+template <typename Completion>
+AsyncBarrier(std::size_t, Completion) -> AsyncBarrier<Completion>;
+
+}  // namespace yaclib
@@ -0,0 +1,328 @@
+#pragma once
+
+#include <yaclib/algo/detail/base_core.hpp>
+#include <yaclib/coro/coro.hpp>
+#include <yaclib/coro/detail/resume.hpp>
+#include <yaclib/log.hpp>
+#include <yaclib/util/detail/intrusive_list.hpp>
+#include <yaclib/util/detail/node.hpp>
+#include <yaclib/util/detail/spinlock.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace yaclib {
+namespace detail {
+
+// Waiter is a part of the awaiter, so it lives in the coroutine frame while the coroutine is suspended
+template <typename T>
+struct ChannelWaiter : Node {
+  BaseCore* core = nullptr;
+  std::optional<T> value;
+  bool ok = false;
+};
+
+template <typename T>
+class ChannelImpl {
+  static_assert(std::is_nothrow_move_constructible_v<T>,
+                "Values are moved between waiters and the buffer inside noexcept AwaitSend and AwaitRecv");
+
+ public:
+  using Waiter = ChannelWaiter<T>;
+
+  explicit ChannelImpl(std::size_t capacity) : _buffer(capacity) {
+  }
+
+  ~ChannelImpl() {
+    YACLIB_ASSERT(_senders.Empty());
+    YACLIB_ASSERT(_receivers.Empty());
+  }
+
+  template <typename U>
+  [[nodiscard]] bool TrySend(U&& value) {
+    _lock.lock();
+    if (_closed) {
+      _lock.unlock();
+      return false;
+    }
+    return SendLocked(std::forward<U>(value));
+  }
+
+  [[nodiscard]] std::optional<T> TryRecv() {
+    std::optional<T> value;
+    List senders;
+    {
+      std::lock_guard lock{_lock};
+      RecvLocked(value, senders);
+    }
+    Resume(senders);
+    return value;
+  }
+
+  template <typename It>
+  std::size_t TryRecvMany(It out, std::size_t max) {
+    std::size_t count = 0;
+    List senders;
+    {
+      std::lock_guard lock{_lock};
+      std::optional<T> value;
+      for (; count != max && RecvLocked(value, senders); ++count) {
+        *out = std::move(*value);
+        ++out;
+        value.reset();
+      }
+    }
+    Resume(senders);
+    return count;
+  }
+
+  void Close() noexcept {
+    List waiters;
+    {
+      std::lock_guard lock{_lock};
+      _closed = true;
+      waiters.PushBack(std::move(_senders));
+      waiters.PushBack(std::move(_receivers));
+    }
+    // Senders get false and receivers get nullopt
+    Resume(waiters);
+  }
+
+  [[nodiscard]] bool Closed() const noexcept {
+    std::lock_guard lock{_lock};
+    return _closed;
+  }
+
+  [[nodiscard]] std::size_t Capacity() const noexcept {
+    return _buffer.size();
+  }
+
+  // Returns true if the sender should be suspended
+  [[nodiscard]] bool AwaitSend(Waiter& sender) noexcept {
+    _lock.lock();
+    if (_closed) {
+      _lock.unlock();
+      return false;
+    }
+    if (_receivers.Empty() && _size == _buffer.size()) {
+      _senders.PushBack(sender);
+      _lock.unlock();
+      return true;
+    }
+    sender.ok = SendLocked(std::move(*sender.value));
+    return false;
+  }
+
+  // Returns true if the receiver should be suspended
+  [[nodiscard]] bool AwaitRecv(Waiter& receiver) noexcept {
+    List senders;
+    {
+      std::lock_guard lock{_lock};
+      if (!RecvLocked(receiver.value, senders)) {
+        if (!_closed) {
+          _receivers.PushBack(receiver);
+          return true;
+        }
+      }
+    }
+    Resume(senders);
+    return false;
+  }
+
+ private:
+  // Unlocks the lock, but before a receiver is resumed
+  template <typename U>
+  bool SendLocked(U&& value) {
+    if (!_receivers.Empty()) {
+      // The buffer is empty, otherwise the receiver wouldn't wait, so the value is passed directly
+      auto& receiver = static_cast<Waiter&>(_receivers.PopFront());
+      _lock.unlock();
+      receiver.value.emplace(std::forward<U>(value));
+      receiver.ok = true;
+      Resume(receiver);
+      return true;
+    }
+    if (_size == _buffer.size()) {
+      _lock.unlock();
+      return false;
+    }
+    _buffer[(_head + _size) % _buffer.size()].emplace(std::forward<U>(value));
+    ++_size;
+    _lock.unlock();
+    return true;
+  }
+
+  bool RecvLocked(std::optional<T>& value, List& resumed) {
+    if (_size != 0) {
+      auto& slot = _buffer[_head];
+      value.emplace(std::move(*slot));
+      slot.reset();
+      _head = (_head + 1) % _buffer.size();
+      --_size;
+      if (!_senders.Empty()) {
+        // The sender waits for the free slot, which is just released
+        auto& sender = static_cast<Waiter&>(_senders.PopFront());
+        _buffer[(_head + _size) % _buffer.size()].emplace(std::move(*sender.value));
+        ++_size;
+        sender.ok = true;
+        resumed.PushBack(sender);
+      }
+      return true;
+    }
+    if (!_senders.Empty()) {
+      // Only possible for the channel without buffer
+      auto& sender = static_cast<Waiter&>(_senders.PopFront());
+      value.emplace(std::move(*sender.value));
+      sender.ok = true;
+      resumed.PushBack(sender);
+      return true;
+    }
+    return false;
+  }
+
+  static void Resume(Waiter& waiter) noexcept {
+    waiter.core->_executor->Submit(*waiter.core);
+  }
+
+  // Waiters usually share the executor, so their coroutines are submitted by batches
+  static void Resume(List& waiters) noexcept {
+    List cores;
+    while (!waiters.Empty()) {
+      cores.PushBack(*static_cast<Waiter&>(waiters.PopFront()).core);
+    }
+    ResumeBatch(cores);
+  }
+
+  std::vector<std::optional<T>> _buffer;
+  std::size_t _head = 0;
+  std::size_t _size = 0;
+  List _senders;
+  List _receivers;
+  bool _closed = false;
+  mutable Spinlock<std::uint32_t> _lock;
+};
+
+template <typename T>
+class [[nodiscard]] SendAwaiter final {
+ public:
+  template <typename U>
+  SendAwaiter(ChannelImpl<T>& channel, U&& value) : _channel{channel} {
+    _waiter.value.emplace(std::forward<U>(value));
+  }
+
+  constexpr bool await_ready() const noexcept {
+    return false;
+  }
+
+  template <typename Promise>
+  YACLIB_INLINE bool await_suspend(yaclib_std::coroutine_handle<Promise> handle) noexcept {
+    _waiter.core = &handle.promise();
+    return _channel.AwaitSend(_waiter);
+  }
+
+  bool await_resume() noexcept {
+    return _waiter.ok;
+  }
+
+ private:
+  ChannelImpl<T>& _channel;
+  ChannelWaiter<T> _waiter;
+};
+
+template <typename T>
+class [[nodiscard]] RecvAwaiter final {
+ public:
+  explicit RecvAwaiter(ChannelImpl<T>& channel) noexcept : _channel{channel} {
+  }
+
+  constexpr bool await_ready() const noexcept {
+    return false;
+  }
+
+  template <typename Promise>
+  YACLIB_INLINE bool await_suspend(yaclib_std::coroutine_handle<Promise> handle) noexcept {
+    _waiter.core = &handle.promise();
+    return _channel.AwaitRecv(_waiter);
+  }
+
+  std::optional<T> await_resume() noexcept {
+    return std::move(_waiter.value);
+  }
+
+ private:
+  ChannelImpl<T>& _channel;
+  ChannelWaiter<T> _waiter;
+};
+
+}  // namespace detail
+
+/**
+ * Bounded MPMC channel for coroutines
+ *
+ * Values are kept in the ring buffer of the fixed capacity. When the buffer is full, senders are suspended,
+ * and when it's empty, receivers are suspended. Suspended coroutines are kept in the intrusive lists,
+ * so waiting doesn't allocate, and they are resumed on their own executors, like with \ref Mutex.
+ * Channel with zero capacity passes every value directly from a sender to a receiver.
+ * \note It does not block execution thread, only coroutine
+ */
+template <typename T>
+class Channel final : protected detail::ChannelImpl<T> {
+ public:
+  using Base = detail::ChannelImpl<T>;
+
+  using Base::Base;
+
+  using Base::Capacity;
+
+  using Base::Close;
+
+  using Base::Closed;
+
+  /**
+   * Push value to the channel, suspends while the buffer is full
+   *
+   * \return false if the channel is closed, the value is dropped then
+   */
+  template <typename U = T>
+  auto Send(U&& value) {
+    return detail::SendAwaiter<T>{*this, std::forward<U>(value)};
+  }
+
+  /**
+   * Pop value from the channel, suspends while the buffer is empty
+   *
+   * \return nullopt if the channel is closed and all values are received
+   */
+  auto Recv() noexcept {
+    return detail::RecvAwaiter<T>{*this};
+  }
+
+  /**
+   * Push value without suspension
+   *
+   * \return false if the channel is closed or full, value isn't moved then
+   */
+  using Base::TrySend;
+
+  /**
+   * Pop value without suspension
+   *
+   * \return nullopt if the channel is empty
+   */
+  using Base::TryRecv;
+
+  /**
+   * Pop up to max values with one synchronization
+   *
+   * \param out output iterator for the values
+   * \return count of received values
+   */
+  using Base::TryRecvMany;
+};
+
+}  // namespace yaclib
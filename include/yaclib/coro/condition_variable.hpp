@@ -0,0 +1,141 @@
+#pragma once
+
+#include <yaclib/algo/detail/base_core.hpp>
+#include <yaclib/coro/coro.hpp>
+#include <yaclib/coro/guard.hpp>
+#include <yaclib/coro/mutex.hpp>
+#include <yaclib/log.hpp>
+#include <yaclib/util/detail/intrusive_list.hpp>
+#include <yaclib/util/detail/spinlock.hpp>
+
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
+namespace yaclib {
+namespace detail {
+
+template <typename M>
+class ConditionVariableImpl {
+ public:
+  using MutexBase = typename M::Base;
+
+  ~ConditionVariableImpl() {
+    YACLIB_ASSERT(_waiters.Empty());
+  }
+
+  void NotifyOne() noexcept {
+    BaseCore* core = nullptr;
+    MutexBase* mutex = nullptr;
+    {
+      std::lock_guard lock{_lock};
+      if (_waiters.Empty()) {
+        return;
+      }
+      core = &static_cast<BaseCore&>(_waiters.PopFront());
+      mutex = _mutex;
+    }
+    Morph(*mutex, *core);
+  }
+
+  void NotifyAll() noexcept {
+    List waiters;
+    MutexBase* mutex = nullptr;
+    {
+      std::lock_guard lock{_lock};
+      waiters.PushBack(std::move(_waiters));
+      mutex = _mutex;
+    }
+    while (!waiters.Empty()) {
+      Morph(*mutex, static_cast<BaseCore&>(waiters.PopFront()));
+    }
+  }
+
+  // The waiter is enqueued before the mutex is unlocked, so notification under the mutex can't be lost
+  void AwaitWait(MutexBase& mutex, BaseCore& curr) noexcept {
+    {
+      std::lock_guard lock{_lock};
+      YACLIB_ASSERT(_waiters.Empty() || _mutex == &mutex);
+      _mutex = &mutex;
+      _waiters.PushBack(curr);
+    }
+    mutex.UnlockHere();
+  }
+
+ private:
+  // Waiter is moved to the waiters of the mutex, so it's resumed only when it owns the mutex
+  static void Morph(MutexBase& mutex, BaseCore& core) noexcept {
+    if (!mutex.AwaitLock(core)) {
+      core._executor->Submit(core);
+    }
+  }
+
+  List _waiters;
+  MutexBase* _mutex = nullptr;
+  Spinlock<std::uint32_t> _lock;
+};
+
+template <typename M>
+class [[nodiscard]] WaitAwaiter final {
+ public:
+  WaitAwaiter(ConditionVariableImpl<M>& cv, typename M::Base& mutex) noexcept : _cv{cv}, _mutex{mutex} {
+  }
+
+  constexpr bool await_ready() const noexcept {
+    return false;
+  }
+
+  template <typename Promise>
+  YACLIB_INLINE void await_suspend(yaclib_std::coroutine_handle<Promise> handle) noexcept {
+    _cv.AwaitWait(_mutex, handle.promise());
+  }
+
+  constexpr void await_resume() const noexcept {
+  }
+
+ private:
+  ConditionVariableImpl<M>& _cv;
+  typename M::Base& _mutex;
+};
+
+}  // namespace detail
+
+/**
+ * Condition variable for coroutines, which works with \ref Mutex
+ *
+ * Notify doesn't resume waiters, it moves them to the waiters of the mutex,
+ * so every waiter is resumed only once, when it owns the mutex, and doesn't contend for it again.
+ * \note It does not block execution thread, only coroutine
+ * \note All waiters at the same time should use the same mutex
+ */
+template <typename M = Mutex<>>
+class AsyncConditionVariable final : protected detail::ConditionVariableImpl<M> {
+ public:
+  using Base = detail::ConditionVariableImpl<M>;
+
+  /**
+   * Unlock the mutex of the guard and suspend until notification, the mutex is locked again after that
+   *
+   * Unlock and enqueue are atomic, so notification under the mutex after the Wait can't be lost.
+   * There are no spurious wakeups, but the condition can be changed by another critical section
+   * between notification and resume, so it should be checked in the loop.
+   * \param guard owns the lock, it still owns the lock after the Wait
+   * \return Awaitable
+   */
+  auto Wait(UniqueGuard<M>& guard) noexcept {
+    YACLIB_ASSERT(guard.OwnsLock());
+    return detail::WaitAwaiter<M>{*this, M::template Cast<typename M::Base>(*guard.Mutex())};
+  }
+
+  /**
+   * Move one waiter to the mutex
+   */
+  using Base::NotifyOne;
+
+  /**
+   * Move all waiters to the mutex
+   */
+  using Base::NotifyAll;
+};
+
+}  // namespace yaclib
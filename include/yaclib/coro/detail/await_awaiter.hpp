@@ -21,7 +21,7 @@ struct [[nodiscard]] TransferAwaiter final {
 
   template <typename Promise>
   YACLIB_INLINE auto await_suspend(yaclib_std::coroutine_handle<Promise> handle) noexcept {
-    _caller.StoreCallback(handle.promise());
+    _caller.StoreCallback(handle.promise(), BaseCore::kAskStop);
     auto* next = MoveToCaller(&_caller.core);
 #if YACLIB_SYMMETRIC_TRANSFER != 0
     return next->Next(handle.promise());
@@ -50,7 +50,7 @@ struct [[nodiscard]] TransferSingleAwaiter final {
 
   template <typename Promise>
   YACLIB_INLINE auto await_suspend(yaclib_std::coroutine_handle<Promise> handle) noexcept {
-    _result->StoreCallback(handle.promise());
+    _result->StoreCallback(handle.promise(), BaseCore::kAskStop);
     auto* next = MoveToCaller(_result.Get());
 #if YACLIB_SYMMETRIC_TRANSFER != 0
     return next->Next(handle.promise());
@@ -93,7 +93,7 @@ struct [[nodiscard]] AwaitAwaiter<Handle, false> final : public AwaitAwaiterBase
 
   template <typename Promise>
   YACLIB_INLINE bool await_suspend(yaclib_std::coroutine_handle<Promise> handle) noexcept {
-    return Handle{*this->_core}.SetCallback(handle.promise());
+    return Handle{*this->_core}.SetCallback(handle.promise(), BaseCore::kAskStop);
   }
 };
 
@@ -213,7 +213,7 @@ class [[nodiscard]] AwaitSingleAwaiter<false, V, E> final {
 
   template <typename Promise>
   YACLIB_INLINE bool await_suspend(yaclib_std::coroutine_handle<Promise> handle) noexcept {
-    return _result->SetCallback(handle.promise());
+    return _result->SetCallback(handle.promise(), BaseCore::kAskStop);
   }
 
   auto await_resume() {
@@ -238,7 +238,7 @@ class [[nodiscard]] AwaitSingleAwaiter<true, V, E> final {
 
   template <typename Promise>
   YACLIB_INLINE bool await_suspend(yaclib_std::coroutine_handle<Promise> handle) const noexcept {
-    return _result->SetCallback(handle.promise());
+    return _result->SetCallback(handle.promise(), BaseCore::kAskStop);
   }
 
   auto await_resume() const {
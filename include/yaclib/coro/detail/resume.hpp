@@ -0,0 +1,37 @@
+#pragma once
+
+#include <yaclib/algo/detail/base_core.hpp>
+#include <yaclib/exe/executor.hpp>
+#include <yaclib/util/detail/intrusive_list.hpp>
+
+#include <cstddef>
+#include <utility>
+
+namespace yaclib::detail {
+
+/**
+ * Submit suspended coroutines to their executors
+ *
+ * Waiters usually resume on the same executor, so the neighbours with the same executor are submitted by one batch.
+ * \param cores intrusive List or Stack of suspended coroutines, it's empty after the call
+ */
+template <typename Cores>
+void ResumeBatch(Cores& cores) noexcept {
+  List batch;
+  std::size_t count = 0;
+  IExecutor* executor = nullptr;
+  while (!cores.Empty()) {
+    auto& core = static_cast<BaseCore&>(cores.PopFront());
+    if (core._executor.Get() != executor && count != 0) {
+      executor->SubmitBatch(batch, std::exchange(count, 0));
+    }
+    executor = core._executor.Get();
+    batch.PushBack(core);
+    ++count;
+  }
+  if (count != 0) {
+    executor->SubmitBatch(batch, count);
+  }
+}
+
+}  // namespace yaclib::detail
@@ -0,0 +1,313 @@
+#pragma once
+
+#include <yaclib/algo/detail/base_core.hpp>
+#include <yaclib/coro/coro.hpp>
+#include <yaclib/log.hpp>
+#include <yaclib/util/cast.hpp>
+#include <yaclib/util/result.hpp>
+
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <yaclib_std/atomic>
+
+namespace yaclib {
+
+template <typename T>
+class AsyncGenerator;
+
+namespace detail {
+
+struct [[nodiscard]] GeneratorYield final {
+  constexpr bool await_ready() const noexcept {
+    return false;
+  }
+
+  template <typename Promise>
+  YACLIB_INLINE auto await_suspend(yaclib_std::coroutine_handle<Promise> handle) noexcept {
+    return handle.promise().ToConsumer();
+  }
+
+  constexpr void await_resume() const noexcept {
+  }
+};
+
+// The copy of the yielded value is a part of the awaiter, so it lives in the coroutine frame until the next element
+template <typename T>
+class [[nodiscard]] GeneratorYieldCopy final {
+ public:
+  explicit GeneratorYieldCopy(const T& value) noexcept(std::is_nothrow_copy_constructible_v<T>) : _value{value} {
+  }
+
+  constexpr bool await_ready() const noexcept {
+    return false;
+  }
+
+  template <typename Promise>
+  YACLIB_INLINE auto await_suspend(yaclib_std::coroutine_handle<Promise> handle) noexcept {
+    auto& promise = handle.promise();
+    promise._value = std::addressof(_value);
+    return promise.ToConsumer();
+  }
+
+  constexpr void await_resume() const noexcept {
+  }
+
+ private:
+  T _value;
+};
+
+/**
+ * Promise of the AsyncGenerator, producer is resumed by the consumer and resumes it back on every element
+ *
+ * Consumer and producer transfer control to each other directly, while they are on the same executor.
+ * When the producer is moved to another executor, the consumer and the producer are submitted to their own executors.
+ * Without symmetric transfer the consumer resumes the producer and continues after the resume returns, so the stack
+ * depth doesn't depend on the count of elements.
+ */
+template <typename T>
+class GeneratorPromise final : public BaseCore {
+  template <typename U>
+  friend class GeneratorYieldCopy;
+  template <typename U>
+  friend class GeneratorNext;
+  friend struct GeneratorYield;
+
+ public:
+  GeneratorPromise() noexcept : BaseCore{kEmpty} {
+  }
+
+  AsyncGenerator<T> get_return_object() noexcept {
+    return AsyncGenerator<T>{Handle()};
+  }
+
+  yaclib_std::suspend_always initial_suspend() noexcept {
+    return {};
+  }
+
+  GeneratorYield final_suspend() noexcept {
+    _finished = true;
+    return {};
+  }
+
+  GeneratorYield yield_value(T&& value) noexcept {
+    _value = std::addressof(value);
+    return {};
+  }
+
+  GeneratorYieldCopy<T> yield_value(const T& value) noexcept(std::is_nothrow_copy_constructible_v<T>) {
+    return GeneratorYieldCopy<T>{value};
+  }
+
+  void return_void() noexcept {
+  }
+
+  void unhandled_exception() noexcept {
+    _exception = std::current_exception();
+  }
+
+  [[nodiscard]] auto Handle() noexcept {
+    return yaclib_std::coroutine_handle<GeneratorPromise>::from_promise(*this);
+  }
+
+ private:
+  [[nodiscard]] auto ToProducer(BaseCore& consumer) noexcept {
+    if (_consumer == nullptr) {
+      // Producer starts on the executor of the consumer
+      _executor = consumer._executor;
+    }
+    _consumer = &consumer;
+    if (_executor.Get() == consumer._executor.Get()) {
+#if YACLIB_SYMMETRIC_TRANSFER != 0
+      YACLIB_TRANSFER(Handle());
+#else
+      // Without symmetric transfer nested resume grows the stack with every element, so the consumer drives the
+      // producer and continues by itself, if the producer reached the next co_yield before resume returned
+      _handoff.store(kDriving, std::memory_order_relaxed);
+      Handle().resume();
+      auto expected = kDriving;
+      return _handoff.compare_exchange_strong(expected, kWaiting, std::memory_order_acq_rel);
+#endif
+    }
+    _executor->Submit(*this);
+    YACLIB_SUSPEND();
+  }
+
+  [[nodiscard]] auto ToConsumer() noexcept {
+    auto& consumer = *_consumer;
+#if YACLIB_SYMMETRIC_TRANSFER != 0
+    if (_executor.Get() == consumer._executor.Get()) {
+      YACLIB_TRANSFER(consumer.Curr());
+    }
+#else
+    if (HandOff()) {
+      YACLIB_SUSPEND();
+    }
+#endif
+    consumer._executor->Submit(consumer);
+    YACLIB_SUSPEND();
+  }
+
+#if YACLIB_SYMMETRIC_TRANSFER == 0
+  static constexpr std::uint32_t kIdle = 0;
+  static constexpr std::uint32_t kDriving = 1;
+  static constexpr std::uint32_t kReady = 2;
+  static constexpr std::uint32_t kWaiting = 3;
+
+  // Returns true if the consumer is still in ToProducer and will continue by itself, otherwise it should be submitted
+  [[nodiscard]] bool HandOff() noexcept {
+    auto expected = kDriving;
+    return _handoff.compare_exchange_strong(expected, kReady, std::memory_order_acq_rel);
+  }
+#endif
+
+  [[nodiscard]] std::optional<T> Take() {
+    if (_exception) {
+      std::rethrow_exception(std::exchange(_exception, nullptr));
+    }
+    if (_value == nullptr) {
+      return std::nullopt;
+    }
+    return std::optional<T>{std::move(*std::exchange(_value, nullptr))};
+  }
+
+  void Call() noexcept final {
+    Handle().resume();
+  }
+
+  void Drop() noexcept final {
+    // Producer can't continue, so the consumer gets the error instead of the next element
+    _exception = std::make_exception_ptr(ResultError<StopError>{StopError{StopTag{}}});
+    _finished = true;
+#if YACLIB_SYMMETRIC_TRANSFER == 0
+    if (HandOff()) {
+      return;
+    }
+#endif
+    _consumer->_executor->Submit(*_consumer);
+  }
+
+  YACLIB_INLINE void Impl(InlineCore& caller) noexcept {
+    _executor = std::move(DownCast<BaseCore>(caller)._executor);
+    YACLIB_ASSERT(_executor != nullptr);
+  }
+  [[nodiscard]] InlineCore* Here(InlineCore& caller) noexcept final {
+    Impl(caller);
+    Call();
+    return nullptr;
+  }
+#if YACLIB_SYMMETRIC_TRANSFER != 0
+  [[nodiscard]] yaclib_std::coroutine_handle<> Next(InlineCore& caller) noexcept final {
+    Impl(caller);
+    return Handle();
+  }
+#endif
+
+  [[nodiscard]] yaclib_std::coroutine_handle<> Curr() noexcept final {
+    return Handle();
+  }
+
+  // Producer isn't needed if nobody needs the result of the consumer
+  [[nodiscard]] bool StopRequested() const noexcept {
+    return _consumer != nullptr && _consumer->StopRequested();
+  }
+
+  [[nodiscard]] const InlineCore* StopNext(bool& stop) const noexcept final {
+    stop = false;
+    return _consumer;
+  }
+
+  BaseCore* _consumer = nullptr;
+  T* _value = nullptr;
+  std::exception_ptr _exception;
+  bool _finished = false;
+#if YACLIB_SYMMETRIC_TRANSFER == 0
+  yaclib_std::atomic_uint32_t _handoff = kIdle;
+#endif
+};
+
+template <typename T>
+class [[nodiscard]] GeneratorNext final {
+ public:
+  explicit GeneratorNext(GeneratorPromise<T>& producer) noexcept : _producer{producer} {
+  }
+
+  bool await_ready() const noexcept {
+    return _producer._finished;
+  }
+
+  template <typename Promise>
+  YACLIB_INLINE auto await_suspend(yaclib_std::coroutine_handle<Promise> handle) noexcept {
+    return _producer.ToProducer(handle.promise());
+  }
+
+  std::optional<T> await_resume() {
+    return _producer.Take();
+  }
+
+ private:
+  GeneratorPromise<T>& _producer;
+};
+
+}  // namespace detail
+
+/**
+ * Coroutine which produces a sequence of values, every co_yield suspends it until the consumer asks the next value
+ *
+ * It's lazy, the body is started by the first \ref Next. Consumer and producer transfer control to each other
+ * without allocations, the only allocation is the coroutine frame. co_yield of rvalue moves the value to the consumer,
+ * co_yield of lvalue copies it. If the producer moves itself to another executor, for example with \ref On,
+ * the consumer is still resumed on its own executor, so values are moved between executors.
+ * \note Generator should be destroyed only when it's not running, i.e. not between Next and the resumption after it
+ */
+template <typename T>
+class AsyncGenerator final {
+  static_assert(!std::is_reference_v<T>, "T should be a value type");
+
+ public:
+  using promise_type = detail::GeneratorPromise<T>;
+
+  AsyncGenerator() noexcept = default;
+
+  AsyncGenerator(AsyncGenerator&& other) noexcept : _handle{std::exchange(other._handle, nullptr)} {
+  }
+
+  AsyncGenerator& operator=(AsyncGenerator&& other) noexcept {
+    std::swap(_handle, other._handle);
+    return *this;
+  }
+
+  ~AsyncGenerator() noexcept {
+    if (_handle) {
+      _handle.destroy();
+    }
+  }
+
+  [[nodiscard]] bool Valid() const noexcept {
+    return static_cast<bool>(_handle);
+  }
+
+  /**
+   * Resume the generator until the next co_yield or the end of the body
+   *
+   * \return awaiter with the next value, or nullopt if the generator is finished.
+   * If the generator throws, the exception is rethrown by co_await of Next
+   */
+  auto Next() noexcept {
+    YACLIB_ASSERT(Valid());
+    return detail::GeneratorNext<T>{_handle.promise()};
+  }
+
+ private:
+  friend promise_type;
+
+  explicit AsyncGenerator(yaclib_std::coroutine_handle<promise_type> handle) noexcept : _handle{handle} {
+  }
+
+  yaclib_std::coroutine_handle<promise_type> _handle;
+};
+
+}  // namespace yaclib
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <yaclib/algo/detail/base_core.hpp>
+#include <yaclib/coro/coro.hpp>
+#include <yaclib/coro/detail/resume.hpp>
+#include <yaclib/log.hpp>
+#include <yaclib/util/detail/intrusive_list.hpp>
+#include <yaclib/util/detail/spinlock.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <yaclib_std/atomic>
+
+namespace yaclib {
+namespace detail {
+
+class LatchImpl {
+ public:
+  explicit LatchImpl(std::size_t count) noexcept : _count{count} {
+  }
+
+  ~LatchImpl() {
+    YACLIB_ASSERT(_waiters.Empty());
+  }
+
+  void CountDown(std::size_t n) noexcept {
+    const auto count = _count.fetch_sub(n, std::memory_order_acq_rel);
+    YACLIB_ASSERT(count >= n);
+    if (count != n) {
+      return;
+    }
+    List waiters;
+    {
+      std::lock_guard lock{_lock};
+      waiters.PushBack(std::move(_waiters));
+    }
+    ResumeBatch(waiters);
+  }
+
+  [[nodiscard]] bool TryWait() const noexcept {
+    return _count.load(std::memory_order_acquire) == 0;
+  }
+
+  // Returns true if the coroutine should be suspended
+  [[nodiscard]] bool AwaitWait(BaseCore& curr) noexcept {
+    std::lock_guard lock{_lock};
+    // The last CountDown takes the waiters after the counter is zero, so it can't miss the waiter added before
+    if (TryWait()) {
+      return false;
+    }
+    _waiters.PushBack(curr);
+    return true;
+  }
+
+ private:
+  yaclib_std::atomic_size_t _count;
+  List _waiters;
+  Spinlock<std::uint32_t> _lock;
+};
+
+template <typename L>
+class [[nodiscard]] LatchAwaiter final {
+ public:
+  explicit LatchAwaiter(L& latch) noexcept : _latch{latch} {
+  }
+
+  YACLIB_INLINE bool await_ready() const noexcept {
+    return _latch.TryWait();
+  }
+
+  template <typename Promise>
+  YACLIB_INLINE bool await_suspend(yaclib_std::coroutine_handle<Promise> handle) noexcept {
+    return _latch.AwaitWait(handle.promise());
+  }
+
+  constexpr void await_resume() const noexcept {
+  }
+
+ private:
+  L& _latch;
+};
+
+}  // namespace detail
+
+/**
+ * Single use countdown latch for coroutines
+ *
+ * Waiters are resumed by the last CountDown, they are submitted to their executors by batches.
+ * For the reusable version see \ref AsyncBarrier.
+ * \note It does not block execution thread, only coroutine
+ */
+class AsyncLatch final : protected detail::LatchImpl {
+ public:
+  using Base = detail::LatchImpl;
+
+  /**
+   * \param count how many times CountDown should be called
+   */
+  using Base::Base;
+
+  /**
+   * Decrement the counter, resume waiters when it's zero
+   */
+  void CountDown(std::size_t n = 1) noexcept {
+    Base::CountDown(n);
+  }
+
+  /**
+   * \return true if the counter is zero
+   */
+  using Base::TryWait;
+
+  /**
+   * Suspend until the counter is zero
+   *
+   * \return Awaitable
+   */
+  auto Wait() noexcept {
+    return detail::LatchAwaiter<Base>{*this};
+  }
+
+  /**
+   * Shortcut for CountDown(n) and Wait()
+   */
+  auto ArriveAndWait(std::size_t n = 1) noexcept {
+    CountDown(n);
+    return Wait();
+  }
+};
+
+}  // namespace yaclib
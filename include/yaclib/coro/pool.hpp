@@ -0,0 +1,316 @@
+#pragma once
+
+#include <yaclib/algo/detail/base_core.hpp>
+#include <yaclib/coro/coro.hpp>
+#include <yaclib/coro/detail/resume.hpp>
+#include <yaclib/log.hpp>
+#include <yaclib/util/detail/intrusive_list.hpp>
+#include <yaclib/util/detail/node.hpp>
+#include <yaclib/util/detail/spinlock.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <yaclib_std/atomic>
+
+namespace yaclib {
+namespace detail {
+
+template <typename T>
+struct PoolSlot final {
+  std::optional<T> value;
+  yaclib_std::atomic_uint32_t next = 0;
+};
+
+// Waiter is a part of the awaiter, so it lives in the coroutine frame while the coroutine is suspended
+template <typename T>
+struct PoolWaiter final : Node {
+  BaseCore* core = nullptr;
+  PoolSlot<T>* slot = nullptr;
+};
+
+template <typename T>
+struct DefaultFactory final {
+  T operator()() const {
+    return T{};
+  }
+};
+
+/**
+ * Free slots are in the lock-free stack of indices, the head has an ABA tag in the high half
+ *
+ * Slot without object is created on the first acquire, so objects are created lazily, up to the capacity.
+ * Released slots are pushed on the top, so already created objects are reused first.
+ */
+template <typename T, typename Factory>
+class PoolImpl {
+ public:
+  using Slot = PoolSlot<T>;
+  using Waiter = PoolWaiter<T>;
+
+  PoolImpl(std::size_t capacity, Factory&& factory) : _slots{new Slot[capacity]}, _factory{std::move(factory)} {
+    YACLIB_ASSERT(capacity < std::numeric_limits<std::uint32_t>::max());
+    for (std::size_t i = capacity; i != 0; --i) {
+      Push(_slots[i - 1]);
+    }
+  }
+
+  ~PoolImpl() {
+    YACLIB_ASSERT(_waiters.Empty());
+  }
+
+  // Waiters are first, so fast path is used only when nobody waits
+  [[nodiscard]] Slot* TryPop() noexcept {
+    if (_waiting.load()) {
+      return nullptr;
+    }
+    return Pop();
+  }
+
+  // Returns true if the coroutine should be suspended
+  [[nodiscard]] bool AwaitAcquire(Waiter& waiter) noexcept {
+    std::lock_guard lock{_lock};
+    // Flag is set before the last check, so Release after it will see the flag and resume the waiter
+    _waiting.store(true);
+    if (auto* slot = Pop(); slot != nullptr) {
+      if (_waiters.Empty()) {
+        _waiting.store(false);
+      }
+      waiter.slot = slot;
+      return false;
+    }
+    _waiters.PushBack(waiter);
+    return true;
+  }
+
+  void Release(Slot& slot) noexcept {
+    if (_waiting.load()) {
+      _lock.lock();
+      if (!_waiters.Empty()) {
+        // Direct handoff, the object doesn't go through the free list
+        auto& waiter = static_cast<Waiter&>(_waiters.PopFront());
+        if (_waiters.Empty()) {
+          _waiting.store(false);
+        }
+        _lock.unlock();
+        waiter.slot = &slot;
+        waiter.core->_executor->Submit(*waiter.core);
+        return;
+      }
+      _waiting.store(false);
+      _lock.unlock();
+    }
+    Push(slot);
+    if (_waiting.load()) {
+      // Waiter was added concurrently and could miss the pushed slot
+      Handoff();
+    }
+  }
+
+  T& Get(Slot& slot) {
+    if (!slot.value) {
+      try {
+        slot.value.emplace(_factory());
+      } catch (...) {
+        Release(slot);
+        throw;
+      }
+    }
+    return *slot.value;
+  }
+
+ private:
+  [[nodiscard]] Slot* Pop() noexcept {
+    auto head = _free.load();
+    while (true) {
+      const auto index = static_cast<std::uint32_t>(head);
+      if (index == 0) {
+        return nullptr;
+      }
+      auto& slot = _slots[index - 1];
+      const auto next = slot.next.load(std::memory_order_relaxed);
+      if (_free.compare_exchange_weak(head, Tag(head) | next)) {
+        return &slot;
+      }
+    }
+  }
+
+  void Push(Slot& slot) noexcept {
+    const auto index = static_cast<std::uint32_t>(&slot - _slots.get() + 1);
+    auto head = _free.load();
+    do {
+      slot.next.store(static_cast<std::uint32_t>(head), std::memory_order_relaxed);
+    } while (!_free.compare_exchange_weak(head, Tag(head) | index));
+  }
+
+  static std::uint64_t Tag(std::uint64_t head) noexcept {
+    return ((head >> std::uint64_t{32}) + 1) << std::uint64_t{32};
+  }
+
+  void Handoff() noexcept {
+    List cores;
+    {
+      std::lock_guard lock{_lock};
+      while (!_waiters.Empty()) {
+        auto* slot = Pop();
+        if (slot == nullptr) {
+          break;
+        }
+        auto& waiter = static_cast<Waiter&>(_waiters.PopFront());
+        waiter.slot = slot;
+        cores.PushBack(*waiter.core);
+      }
+      if (_waiters.Empty()) {
+        _waiting.store(false);
+      }
+    }
+    ResumeBatch(cores);
+  }
+
+  std::unique_ptr<Slot[]> _slots;
+  // Free list and flag use sequentially consistent operations, so Release and AwaitAcquire can't miss each other
+  yaclib_std::atomic_uint64_t _free = 0;
+  yaclib_std::atomic_bool _waiting = false;
+  List _waiters;
+  Spinlock<std::uint32_t> _lock;
+  Factory _factory;
+};
+
+}  // namespace detail
+
+/**
+ * Pool of objects for coroutines
+ *
+ * Acquire takes the free object without locks, or suspends when the pool is empty.
+ * Objects are created lazily by factory, when there is no free object and the count of objects is less than capacity.
+ * Lease returns the object to the pool, or hands it directly to the next waiter, which is resumed on its executor.
+ * \note It does not block execution thread, only coroutine
+ * \note Pool should be alive until all leases are destroyed
+ * \tparam Factory func without arguments which returns T, if it throws, the exception is rethrown by Acquire
+ */
+template <typename T, typename Factory = detail::DefaultFactory<T>>
+class AsyncPool final : protected detail::PoolImpl<T, Factory> {
+  using Slot = detail::PoolSlot<T>;
+
+ public:
+  using Base = detail::PoolImpl<T, Factory>;
+
+  /**
+   * RAII owner of the object from the pool
+   */
+  class [[nodiscard]] Lease final {
+   public:
+    Lease() noexcept = default;
+
+    Lease(Lease&& other) noexcept
+      : _pool{std::exchange(other._pool, nullptr)}, _slot{std::exchange(other._slot, nullptr)} {
+    }
+
+    Lease& operator=(Lease&& other) noexcept {
+      std::swap(_pool, other._pool);
+      std::swap(_slot, other._slot);
+      return *this;
+    }
+
+    ~Lease() noexcept {
+      Release();
+    }
+
+    /**
+     * Return the object to the pool before the destruction of the lease
+     */
+    void Release() noexcept {
+      if (_slot != nullptr) {
+        _pool->Release(*std::exchange(_slot, nullptr));
+      }
+    }
+
+    [[nodiscard]] explicit operator bool() const noexcept {
+      return _slot != nullptr;
+    }
+
+    [[nodiscard]] T& operator*() const noexcept {
+      YACLIB_ASSERT(_slot != nullptr);
+      return *_slot->value;
+    }
+
+    [[nodiscard]] T* operator->() const noexcept {
+      return &**this;
+    }
+
+   private:
+    friend class AsyncPool;
+
+    Lease(Base& pool, Slot& slot) : _pool{&pool}, _slot{&slot} {
+      // If the factory throws, the slot is already returned
+      pool.Get(slot);
+    }
+
+    Base* _pool = nullptr;
+    Slot* _slot = nullptr;
+  };
+
+  /**
+   * \param capacity max count of objects
+   * \param factory creates objects, by default they are value initialized
+   */
+  explicit AsyncPool(std::size_t capacity, Factory factory = {}) : Base{capacity, std::move(factory)} {
+  }
+
+  /**
+   * Take the object, suspends while the pool is empty
+   *
+   * \return Awaitable, which await_resume returns the Lease
+   */
+  auto Acquire() noexcept {
+    return AcquireAwaiter{*this};
+  }
+
+  /**
+   * Take the object without suspension
+   *
+   * \return Lease, which is empty if the pool is empty
+   */
+  [[nodiscard]] Lease TryAcquire() {
+    if (auto* slot = Base::TryPop(); slot != nullptr) {
+      return Lease{*this, *slot};
+    }
+    return Lease{};
+  }
+
+ private:
+  class [[nodiscard]] AcquireAwaiter final {
+   public:
+    explicit AcquireAwaiter(AsyncPool& pool) noexcept : _pool{pool} {
+    }
+
+    YACLIB_INLINE bool await_ready() noexcept {
+      _waiter.slot = _pool.TryPop();
+      return _waiter.slot != nullptr;
+    }
+
+    template <typename Promise>
+    YACLIB_INLINE bool await_suspend(yaclib_std::coroutine_handle<Promise> handle) noexcept {
+      _waiter.core = &handle.promise();
+      return _pool.AwaitAcquire(_waiter);
+    }
+
+    Lease await_resume() {
+      return Lease{_pool, *_waiter.slot};
+    }
+
+   private:
+    AsyncPool& _pool;
+    typename Base::Waiter _waiter;
+  };
+};
+
+template <typename Factory>
+AsyncPool(std::size_t, Factory) -> AsyncPool<std::invoke_result_t<Factory&>, Factory>;
+
+}  // namespace yaclib
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <yaclib/algo/detail/base_core.hpp>
+#include <yaclib/coro/coro.hpp>
+#include <yaclib/coro/detail/resume.hpp>
+#include <yaclib/log.hpp>
+#include <yaclib/util/detail/intrusive_list.hpp>
+#include <yaclib/util/detail/node.hpp>
+#include <yaclib/util/detail/spinlock.hpp>
+
+#include <cstdint>
+#include <mutex>
+#include <yaclib_std/atomic>
+
+namespace yaclib {
+namespace detail {
+
+// Waiter is a part of the awaiter, so it lives in the coroutine frame while the coroutine is suspended
+struct SemaphoreWaiter : Node {
+  BaseCore* core = nullptr;
+  std::uint64_t count = 0;
+};
+
+class SemaphoreImpl {
+ public:
+  explicit SemaphoreImpl(std::uint64_t permits) noexcept : _state{permits} {
+    YACLIB_ASSERT(permits < kWaiters);
+  }
+
+  ~SemaphoreImpl() {
+    YACLIB_ASSERT(_waiters.Empty());
+  }
+
+  [[nodiscard]] bool TryAcquire(std::uint64_t n) noexcept {
+    auto s = _state.load(std::memory_order_relaxed);
+    do {
+      // Waiters are first, so the big request isn't starved by the small ones
+      if (s < n || (s & kWaiters) != 0) {
+        return false;
+      }
+    } while (!_state.compare_exchange_weak(s, s - n, std::memory_order_acquire, std::memory_order_relaxed));
+    return true;
+  }
+
+  void Release(std::uint64_t n) noexcept {
+    auto s = _state.load(std::memory_order_relaxed);
+    while ((s & kWaiters) == 0) {
+      if (_state.compare_exchange_weak(s, s + n, std::memory_order_release, std::memory_order_relaxed)) {
+        return;
+      }
+    }
+    SlowRelease(n);
+  }
+
+  [[nodiscard]] std::uint64_t Available() const noexcept {
+    auto s = _state.load(std::memory_order_relaxed);
+    return s & ~kWaiters;
+  }
+
+  // Returns true if the coroutine should be suspended
+  [[nodiscard]] bool AwaitAcquire(SemaphoreWaiter& waiter) noexcept {
+    std::lock_guard lock{_lock};
+    auto s = _state.load(std::memory_order_relaxed);
+    do {
+      if (s >= waiter.count && (s & kWaiters) == 0) {
+        if (_state.compare_exchange_weak(s, s - waiter.count, std::memory_order_acquire, std::memory_order_relaxed)) {
+          return false;
+        }
+      } else if (_state.compare_exchange_weak(s, s | kWaiters, std::memory_order_relaxed, std::memory_order_relaxed)) {
+        break;
+      }
+    } while (true);
+    _waiters.PushBack(waiter);
+    return true;
+  }
+
+ private:
+  // Only the lock owner resets the flag, so while it's set, permits are changed only under the lock
+  static constexpr auto kWaiters = std::uint64_t{1} << std::uint64_t{63};
+
+  void SlowRelease(std::uint64_t n) noexcept {
+    _lock.lock();
+    auto s = _state.load(std::memory_order_acquire);
+    if ((s & kWaiters) == 0) {
+      // Other SlowRelease served the last waiter while we were waiting for the lock,
+      // so lock-free TryAcquire and Release can change permits concurrently
+      _state.fetch_add(n, std::memory_order_release);
+      _lock.unlock();
+      return;
+    }
+    auto permits = (s & ~kWaiters) + n;
+    std::uint64_t taken = 0;
+    List ready;
+    while (!_waiters.Empty()) {
+      auto& waiter = static_cast<SemaphoreWaiter&>(_waiters.PopFront());
+      if (waiter.count > permits - taken) {
+        _waiters.PushFront(waiter);
+        break;
+      }
+      taken += waiter.count;
+      ready.PushBack(*waiter.core);
+    }
+    const auto waiters = _waiters.Empty() ? std::uint64_t{0} : kWaiters;
+    while (!_state.compare_exchange_weak(s, ((s & ~kWaiters) + n - taken) | waiters, std::memory_order_acq_rel,
+                                         std::memory_order_acquire)) {
+    }
+    _lock.unlock();
+    ResumeBatch(ready);
+  }
+
+  // The highest bit is set if there are waiters, other bits are count of available permits
+  yaclib_std::atomic_uint64_t _state;
+  List _waiters;
+  Spinlock<std::uint32_t> _lock;
+};
+
+class [[nodiscard]] AcquireAwaiter final {
+ public:
+  AcquireAwaiter(SemaphoreImpl& semaphore, std::uint64_t n) noexcept : _semaphore{semaphore} {
+    _waiter.count = n;
+  }
+
+  YACLIB_INLINE bool await_ready() noexcept {
+    return _semaphore.TryAcquire(_waiter.count);
+  }
+
+  template <typename Promise>
+  YACLIB_INLINE bool await_suspend(yaclib_std::coroutine_handle<Promise> handle) noexcept {
+    _waiter.core = &handle.promise();
+    return _semaphore.AwaitAcquire(_waiter);
+  }
+
+  constexpr void await_resume() noexcept {
+  }
+
+ private:
+  SemaphoreImpl& _semaphore;
+  SemaphoreWaiter _waiter;
+};
+
+}  // namespace detail
+
+/**
+ * Counting semaphore for coroutines, with weighted permits
+ *
+ * Acquire and Release don't take the lock while nobody waits. Waiters are resumed in FIFO order,
+ * so the request for many permits isn't starved by the requests for few ones.
+ * Release resumes all waiters which got their permits, they are submitted to their executors by batches.
+ * \note It does not block execution thread, only coroutine
+ */
+class AsyncSemaphore final : protected detail::SemaphoreImpl {
+ public:
+  using Base = detail::SemaphoreImpl;
+
+  /**
+   * \param permits initial count of permits
+   */
+  using Base::Base;
+
+  /**
+   * Acquire n permits, suspends until they are available
+   *
+   * \return Awaitable
+   */
+  auto Acquire(std::uint64_t n = 1) noexcept {
+    return detail::AcquireAwaiter{*this, n};
+  }
+
+  /**
+   * Try to acquire n permits without suspension
+   *
+   * \return true if permits are acquired
+   */
+  [[nodiscard]] bool TryAcquire(std::uint64_t n = 1) noexcept {
+    return Base::TryAcquire(n);
+  }
+
+  /**
+   * Return n permits and resume waiters which can get them
+   */
+  void Release(std::uint64_t n = 1) noexcept {
+    Base::Release(n);
+  }
+
+  /**
+   * Count of available permits, it can be changed concurrently
+   */
+  using Base::Available;
+};
+
+}  // namespace yaclib
@@ -3,11 +3,13 @@
 #include <yaclib/coro/coro.hpp>
 #include <yaclib/coro/detail/mutex_awaiter.hpp>
 #include <yaclib/coro/detail/promise_type.hpp>
+#include <yaclib/coro/detail/resume.hpp>
 #include <yaclib/coro/guard.hpp>
 #include <yaclib/util/detail/intrusive_list.hpp>
 #include <yaclib/util/detail/intrusive_stack.hpp>
 #include <yaclib/util/detail/spinlock.hpp>
 
+#include <utility>
 #include <yaclib_std/atomic>
 
 namespace yaclib {
@@ -136,9 +138,7 @@ struct SharedMutexImpl {
     _readers_size = 0;
     _lock.unlock();
 
-    do {
-      Run(&readers.PopFront());
-    } while (!readers.Empty());
+    ResumeBatch(readers);
   }
 
   void SlowUnlock() noexcept {
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <yaclib/coro/coro.hpp>
+#include <yaclib/exe/job.hpp>
+
+namespace yaclib {
+namespace detail {
+
+template <bool Point>
+class [[nodiscard]] StopAwaiter final {
+ public:
+  constexpr bool await_ready() const noexcept {
+    return false;
+  }
+
+  template <typename Promise>
+  YACLIB_INLINE bool await_suspend(yaclib_std::coroutine_handle<Promise> handle) noexcept {
+    auto& promise = handle.promise();
+    _stop = promise.StopRequested();
+    if constexpr (Point) {
+      if (_stop) {
+        // Coroutine frame can be destroyed here, so we don't touch *this after it
+        static_cast<Job&>(promise).Drop();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  YACLIB_INLINE bool await_resume() const noexcept {
+    return _stop;
+  }
+
+ private:
+  bool _stop = false;
+};
+
+}  // namespace detail
+
+/**
+ * Check if nobody needs the result of the current coroutine anymore
+ *
+ * \code
+ * while (!co_await yaclib::StopRequested()) {
+ *   // some long computations
+ * }
+ * \endcode
+ */
+YACLIB_INLINE detail::StopAwaiter<false> StopRequested() noexcept {
+  return {};
+}
+
+/**
+ * Cancellation point: if stop is requested, the coroutine isn't resumed and completes with StopError
+ */
+YACLIB_INLINE detail::StopAwaiter<true> StopPoint() noexcept {
+  return {};
+}
+
+}  // namespace yaclib
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <yaclib/algo/detail/base_core.hpp>
+#include <yaclib/async/when_each.hpp>
+#include <yaclib/coro/coro.hpp>
+#include <yaclib/util/helper.hpp>
+#include <yaclib/util/intrusive_ptr.hpp>
+#include <yaclib/util/ref.hpp>
+#include <yaclib/util/result.hpp>
+
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+#include <yaclib_std/atomic>
+#include <yaclib_std/mutex>
+
+namespace yaclib {
+namespace detail {
+
+template <typename V, typename E>
+class EachQueue : public IRef {
+ public:
+  using Item = std::pair<std::size_t, Result<V, E>>;
+
+  // At most count items are pushed, so Push never allocates
+  explicit EachQueue(std::size_t count) : _remaining{count} {
+    _items.reserve(count);
+  }
+
+  void Push(std::size_t index, Result<V, E>&& result) noexcept {
+    BaseCore* waiter = nullptr;
+    {
+      std::lock_guard lock{_m};
+      --_remaining;
+      if (!_closed.load(std::memory_order_relaxed)) {
+        _items.emplace_back(index, std::move(result));
+      }
+      waiter = std::exchange(_waiter, nullptr);
+    }
+    if (waiter != nullptr) {
+      waiter->_executor->Submit(*waiter);
+    }
+  }
+
+  [[nodiscard]] bool Closed() const noexcept {
+    return _closed.load(std::memory_order_acquire);
+  }
+
+  void Close() noexcept {
+    std::lock_guard lock{_m};
+    _closed.store(true, std::memory_order_release);
+    std::vector<Item>{}.swap(_items);
+  }
+
+  [[nodiscard]] bool Await(BaseCore& waiter) noexcept {
+    std::lock_guard lock{_m};
+    if (!_items.empty() || _remaining == 0) {
+      return false;
+    }
+    _waiter = &waiter;
+    return true;
+  }
+
+  // batch is empty and has the same capacity, so the capacity of the queue and the batch is reused
+  void Take(std::vector<Item>& batch) noexcept {
+    std::lock_guard lock{_m};
+    batch.swap(_items);
+  }
+
+ private:
+  yaclib_std::mutex _m;
+  std::vector<Item> _items;
+  std::size_t _remaining;
+  BaseCore* _waiter = nullptr;
+  yaclib_std::atomic_bool _closed = false;
+};
+
+template <typename V, typename E>
+struct EachPush {
+  void operator()(std::size_t index, Result<V, E>&& result) noexcept {
+    _queue->Push(index, std::move(result));
+  }
+
+  [[nodiscard]] bool StopRequested() const noexcept {
+    return _queue->Closed();
+  }
+
+  IntrusivePtr<EachQueue<V, E>> _queue;
+};
+
+}  // namespace detail
+
+/**
+ * Async iterator over results of the futures in the order of their completion
+ *
+ * Holds only results which are ready, but not consumed yet.
+ * Destruction of the stream requests stop for the futures which aren't ready yet.
+ * \code
+ * auto each = yaclib::WhenEach(futures.begin(), futures.size());
+ * while (auto item = co_await each.Next()) {
+ *   auto& [index, result] = *item;
+ * }
+ * \endcode
+ */
+template <typename V, typename E>
+class EachStream final {
+  using Queue = detail::EachQueue<V, E>;
+
+ public:
+  using Item = typename Queue::Item;
+
+  // Batch is swapped with the queue, so it needs the same capacity
+  EachStream(IntrusivePtr<Queue> queue, std::size_t count) : _queue{std::move(queue)} {
+    _batch.reserve(count);
+  }
+
+  EachStream(EachStream&& other) noexcept = default;
+  EachStream& operator=(EachStream&& other) = delete;
+
+  ~EachStream() {
+    if (_queue != nullptr) {
+      _queue->Close();
+    }
+  }
+
+  /**
+   * \return awaiter, which returns next item, or std::nullopt if all items are consumed
+   */
+  auto Next() noexcept {
+    return Awaiter{*this};
+  }
+
+ private:
+  class [[nodiscard]] Awaiter final {
+   public:
+    explicit Awaiter(EachStream& stream) noexcept : _stream{stream} {
+    }
+
+    YACLIB_INLINE bool await_ready() noexcept {
+      return _stream._pos != _stream._batch.size() || _stream.Refill();
+    }
+
+    template <typename Promise>
+    YACLIB_INLINE bool await_suspend(yaclib_std::coroutine_handle<Promise> handle) noexcept {
+      return _stream._queue->Await(handle.promise());
+    }
+
+    YACLIB_INLINE std::optional<Item> await_resume() noexcept {
+      if (_stream._pos == _stream._batch.size()) {
+        _stream.Refill();
+      }
+      if (_stream._pos == _stream._batch.size()) {
+        return std::nullopt;
+      }
+      return std::move(_stream._batch[_stream._pos++]);
+    }
+
+   private:
+    EachStream& _stream;
+  };
+
+  bool Refill() noexcept {
+    _batch.clear();
+    _pos = 0;
+    _queue->Take(_batch);
+    return !_batch.empty();
+  }
+
+  IntrusivePtr<Queue> _queue;
+  std::vector<Item> _batch;
+  std::size_t _pos = 0;
+};
+
+/**
+ * Create \ref EachStream over the futures, see \ref EachStream
+ */
+template <typename It, typename T = typename std::iterator_traits<It>::value_type>
+auto WhenEach(It begin, std::size_t count) {
+  using V = typename T::Core::Value;
+  using E = typename T::Core::Error;
+  IntrusivePtr<detail::EachQueue<V, E>> queue{NoRefTag{}, MakeShared<detail::EachQueue<V, E>>(1, count).Release()};
+  // Everything is allocated before the futures are attached
+  EachStream<V, E> stream{queue, count};
+  auto f = WhenEach(begin, count, detail::EachPush<V, E>{std::move(queue)});
+  if (f.Valid()) {
+    std::move(f).Detach();
+  }
+  return stream;
+}
+
+template <typename It, typename T = typename std::iterator_traits<It>::value_type>
+auto WhenEach(It begin, It end) {
+  return WhenEach(begin, static_cast<std::size_t>(end - begin));
+}
+
+}  // namespace yaclib
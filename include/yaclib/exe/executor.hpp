@@ -1,8 +1,11 @@
 #pragma once
 
 #include <yaclib/exe/job.hpp>
+#include <yaclib/util/detail/intrusive_list.hpp>
 #include <yaclib/util/intrusive_ptr.hpp>
 
+#include <cstddef>
+
 namespace yaclib {
 
 class IExecutor : public IRef {
@@ -19,6 +22,7 @@ class IExecutor : public IRef {
    * SingleThread
    * FairThreadPool
    * GolangThreadPool
+   * LockFreeThreadPool
    */
   enum class Type : unsigned char {
     Custom = 0,
@@ -28,6 +32,7 @@ class IExecutor : public IRef {
     SingleThread = 4,
     FairThreadPool = 5,
     GolangThreadPool = 6,
+    LockFreeThreadPool = 7,
   };
 
   /**
@@ -49,6 +54,16 @@ class IExecutor : public IRef {
    * \param job job to execute
    */
   virtual void Submit(Job& job) noexcept = 0;
+
+  /**
+   * Submit all jobs from the list, after this call the list is empty
+   *
+   * Default implementation calls Submit for every job.
+   * Executors override it to push the whole list with one lock acquisition or CAS and to wake only needed workers.
+   * \param jobs jobs to execute, in the submission order
+   * \param count number of jobs in the list
+   */
+  virtual void SubmitBatch(detail::List& jobs, std::size_t count) noexcept;
 };
 
 using IExecutorPtr = IntrusivePtr<IExecutor>;
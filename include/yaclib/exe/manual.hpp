@@ -19,6 +19,8 @@ class ManualExecutor : public IExecutor {
 
   void Submit(Job& f) noexcept final;
 
+  void SubmitBatch(detail::List& jobs, std::size_t count) noexcept final;
+
   [[nodiscard]] std::size_t Drain() noexcept;
 
  private:
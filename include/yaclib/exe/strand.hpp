@@ -20,11 +20,15 @@ class Strand : private Job, public IExecutor {
 
   void Submit(Job& job) noexcept final;
 
+  void SubmitBatch(detail::List& jobs, std::size_t count) noexcept final;
+
  private:
   void Call() noexcept final;
 
   void Drop() noexcept final;
 
+  void Push(Node& top, Node& bottom) noexcept;
+
   Node* Mark() noexcept;
 
   IExecutorPtr _executor;
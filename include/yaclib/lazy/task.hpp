@@ -139,6 +139,9 @@ class Task final {
   [[nodiscard]] detail::UniqueCorePtr<V, E>& GetCore() noexcept {
     return _core;
   }
+
+  using Core = detail::UniqueCore<V, E>;
+
   Task(detail::UniqueCorePtr<V, E> core) noexcept : _core{std::move(core)} {
   }
 
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <yaclib_std/atomic>
+#include <yaclib_std/condition_variable>
+#include <yaclib_std/mutex>
+#include <yaclib_std/thread>
+
+namespace yaclib::detail {
+
+/**
+ * Spin and park protocol of the idle thread pool workers
+ *
+ * Only idle workers spin, at most a half of workers, and WakeUp doesn't notify while someone spins.
+ * The notified worker is accounted as spinner, so the burst of submits costs at most one wakeup.
+ * When the spinner finds a job and it was the last one, the pool wakes up the next worker if jobs remain.
+ * Mutex and condition variable are owned by the pool, because they also protect its queue and stop state.
+ */
+class IdleWorkers final {
+ public:
+  static constexpr std::uint32_t kYieldPeriod = 64;
+
+  /**
+   * \param count number of workers
+   * \param spin_budget how many times idle worker polls the queue before park, 0 disables spinning
+   */
+  IdleWorkers(std::uint32_t count, std::uint32_t spin_budget) noexcept;
+
+  [[nodiscard]] bool StartSpinning() noexcept;
+
+  /**
+   * Poll the queue at most spin budget times, the thread is yielded after every kYieldPeriod polls
+   * \return true if has_jobs returned true
+   */
+  template <typename HasJobs>
+  [[nodiscard]] bool Spin(HasJobs&& has_jobs) const noexcept {
+    for (std::uint32_t i = 0; i != _spin_budget; ++i) {
+      if (has_jobs()) {
+        return true;
+      }
+      if ((i + 1) % kYieldPeriod == 0) {
+        yaclib_std::this_thread::yield();
+      }
+    }
+    return false;
+  }
+
+  /**
+   * Spinner found a job
+   * \return true if it was the last spinner, then the pool should call WakeUp if it has more jobs
+   */
+  [[nodiscard]] bool StopSpinning() noexcept;
+
+  /**
+   * Spinner didn't find a job and is going to park, it should recheck the queue after that
+   */
+  void CancelSpinning() noexcept;
+
+  /**
+   * Should be called under the pool mutex, before the check of the queue and wait
+   */
+  void Park() noexcept;
+
+  /**
+   * Should be called under the pool mutex, after wait
+   * \return true if the worker was notified by WakeUp, then it's already accounted as spinner
+   */
+  [[nodiscard]] bool Woken() noexcept;
+
+  /**
+   * Should be called under the pool mutex, when the worker stops waiting
+   */
+  void Unpark() noexcept;
+
+  /**
+   * Should be called under the pool mutex
+   */
+  [[nodiscard]] std::uint32_t Sleeping() const noexcept;
+
+  /**
+   * Should be called after the job is published with seq_cst, because Park increments sleeping and then checks jobs
+   */
+  void WakeUp(yaclib_std::mutex& m, yaclib_std::condition_variable& idle) noexcept;
+
+ private:
+  yaclib_std::atomic_uint32_t _spinning{0};
+  yaclib_std::atomic_uint32_t _sleeping{0};
+  std::uint32_t _count;
+  std::uint32_t _spin_budget;
+  // Guarded by the pool mutex, count of notified workers which haven't woken up yet
+  std::uint32_t _wakeups{0};
+};
+
+}  // namespace yaclib::detail
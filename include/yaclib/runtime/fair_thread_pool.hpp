@@ -2,10 +2,13 @@
 
 #include <yaclib/exe/executor.hpp>
 #include <yaclib/exe/job.hpp>
+#include <yaclib/runtime/detail/idle_workers.hpp>
 #include <yaclib/util/detail/intrusive_list.hpp>
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
+#include <yaclib_std/atomic>
 #include <yaclib_std/condition_variable>
 #include <yaclib_std/mutex>
 #include <yaclib_std/thread>
@@ -17,7 +20,14 @@ namespace yaclib {
  */
 class FairThreadPool : public IExecutor {
  public:
-  explicit FairThreadPool(std::uint64_t threads = yaclib_std::thread::hardware_concurrency());
+  static constexpr std::uint32_t kSpinBudget = 4096;
+
+  /**
+   * \param threads number of workers
+   * \param spin_budget how many times idle worker polls the queue before park, 0 disables spinning
+   */
+  explicit FairThreadPool(std::uint64_t threads = yaclib_std::thread::hardware_concurrency(),
+                          std::uint32_t spin_budget = kSpinBudget);
 
   ~FairThreadPool() noexcept override;
 
@@ -27,6 +37,11 @@ class FairThreadPool : public IExecutor {
 
   void Submit(Job& task) noexcept final;
 
+  /**
+   * Splice the whole list under one lock acquisition and wake up workers the same way as Submit does
+   */
+  void SubmitBatch(detail::List& jobs, std::size_t count) noexcept final;
+
   void SoftStop() noexcept;
 
   void Stop() noexcept;
@@ -47,6 +62,13 @@ class FairThreadPool : public IExecutor {
 
   void Stop(std::unique_lock<yaclib_std::mutex>&& lock) noexcept;
 
+  void StopSpinning() noexcept;
+  void WakeUp() noexcept;
+
+  // Count of jobs in the queue, idle workers poll it without the lock
+  yaclib_std::atomic_size_t _queued{0};
+  detail::IdleWorkers _idle_workers;
+
   std::vector<yaclib_std::thread> _workers;
   mutable yaclib_std::mutex _m;
   yaclib_std::condition_variable _idle;
@@ -54,6 +76,7 @@ class FairThreadPool : public IExecutor {
   std::uint64_t _jobs_count;
 };
 
-IntrusivePtr<FairThreadPool> MakeFairThreadPool(std::uint64_t threads = yaclib_std::thread::hardware_concurrency());
+IntrusivePtr<FairThreadPool> MakeFairThreadPool(std::uint64_t threads = yaclib_std::thread::hardware_concurrency(),
+                                                std::uint32_t spin_budget = FairThreadPool::kSpinBudget);
 
 }  // namespace yaclib
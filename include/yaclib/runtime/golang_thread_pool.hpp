@@ -0,0 +1,92 @@
+#pragma once
+
+#include <yaclib/exe/executor.hpp>
+#include <yaclib/exe/job.hpp>
+#include <yaclib/util/detail/intrusive_list.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <yaclib_std/atomic>
+#include <yaclib_std/condition_variable>
+#include <yaclib_std/mutex>
+#include <yaclib_std/thread>
+
+namespace yaclib {
+namespace detail {
+
+struct GolangWorker;
+
+}  // namespace detail
+
+/**
+ * Work-stealing thread pool, scheduling is close to the golang runtime one
+ *
+ * Every worker owns a bounded local queue and a LIFO "next" slot.
+ * Jobs submitted from a worker go to its "next" slot, previous "next" job goes to the local queue.
+ * Jobs submitted from outside, and half of the overflowed local queue, go to the global queue.
+ * Idle worker checks its own queue, then the global queue, then tries to steal half of the queue of a random worker.
+ * Only when all of this failed worker parks.
+ */
+class GolangThreadPool : public IExecutor {
+ public:
+  explicit GolangThreadPool(std::uint64_t threads = yaclib_std::thread::hardware_concurrency());
+
+  ~GolangThreadPool() noexcept override;
+
+  [[nodiscard]] Type Tag() const noexcept final;
+
+  [[nodiscard]] bool Alive() const noexcept final;
+
+  void Submit(Job& job) noexcept final;
+
+  /**
+   * Splice the whole list to the global queue under one lock acquisition,
+   * then wake up one spinning worker, which wakes up the next one when it finds a job
+   */
+  void SubmitBatch(detail::List& jobs, std::size_t count) noexcept final;
+
+  void SoftStop() noexcept;
+
+  void Stop() noexcept;
+
+  void HardStop() noexcept;
+
+  void Wait() noexcept;
+
+ private:
+  using Worker = detail::GolangWorker;
+
+  void Loop(Worker& worker) noexcept;
+
+  Job* FindJob(Worker& worker, bool& spinning) noexcept;
+  Job* PopGlobal(Worker& worker) noexcept;
+  Job* Steal(Worker& worker) noexcept;
+  bool Park(bool& spinning) noexcept;
+
+  void PushGlobal(detail::List& jobs, std::uint32_t count) noexcept;
+  void WakeUp() noexcept;
+
+  [[nodiscard]] bool HasJobs() const noexcept;
+  void Stop(std::unique_lock<yaclib_std::mutex>&& lock, std::uint32_t state) noexcept;
+
+  std::uint32_t _count;
+  std::unique_ptr<Worker[]> _local;
+  std::vector<yaclib_std::thread> _workers;
+
+  yaclib_std::atomic_uint32_t _state{0};
+  yaclib_std::atomic_uint32_t _spinning{0};
+  yaclib_std::atomic_uint32_t _sleeping{0};
+  yaclib_std::atomic_size_t _global_count{0};
+
+  mutable yaclib_std::mutex _m;
+  yaclib_std::condition_variable _idle;
+  std::uint32_t _wakeups{0};
+  detail::List _global;
+};
+
+IntrusivePtr<GolangThreadPool> MakeGolangThreadPool(
+  std::uint64_t threads = yaclib_std::thread::hardware_concurrency());
+
+}  // namespace yaclib
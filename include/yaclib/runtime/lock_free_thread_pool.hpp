@@ -0,0 +1,102 @@
+#pragma once
+
+#include <yaclib/exe/executor.hpp>
+#include <yaclib/exe/job.hpp>
+#include <yaclib/runtime/detail/idle_workers.hpp>
+#include <yaclib/util/detail/intrusive_list.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <yaclib_std/atomic>
+#include <yaclib_std/condition_variable>
+#include <yaclib_std/mutex>
+#include <yaclib_std/thread>
+
+namespace yaclib {
+
+/**
+ * Thread pool with the same FIFO semantic as FairThreadPool, but jobs are stored in the lock-free MPMC queue
+ *
+ * Submit and pop are lock-free, when the bounded queue is full jobs go to the intrusive overflow list.
+ * Mutex is used only to park and wake up idle workers, and for the overflow list.
+ * Idle workers spin before park, and Submit wakes up a worker only when nobody spins and no wakeup is pending,
+ * so the burst of submits costs at most one wakeup, see detail::IdleWorkers.
+ *
+ * Overflow mode: once the overflow list isn't empty, every Submit takes the mutex and appends to the list,
+ * until workers move the list back to the queue, so capacity should fit the expected burst of jobs.
+ * Jobs of one producer are executed in FIFO order. Jobs of different producers are ordered as they land in
+ * the queue or in the list, so a job, which is pushed to the queue concurrently with the transition to overflow
+ * mode, can run before the job which overflowed first.
+ */
+class LockFreeThreadPool : public IExecutor {
+ public:
+  static constexpr std::uint32_t kSpinBudget = 4096;
+
+  /**
+   * \param threads number of workers
+   * \param capacity size of the lock-free queue, it's rounded up to the power of two
+   * \param spin_budget how many times idle worker polls the queue before park, 0 disables spinning
+   */
+  explicit LockFreeThreadPool(std::uint64_t threads = yaclib_std::thread::hardware_concurrency(),
+                              std::size_t capacity = 4096, std::uint32_t spin_budget = kSpinBudget);
+
+  ~LockFreeThreadPool() noexcept override;
+
+  [[nodiscard]] Type Tag() const noexcept final;
+
+  [[nodiscard]] bool Alive() const noexcept final;
+
+  void Submit(Job& job) noexcept final;
+
+  void SoftStop() noexcept;
+
+  void Stop() noexcept;
+
+  void HardStop() noexcept;
+
+  void Wait() noexcept;
+
+ private:
+  struct Cell {
+    yaclib_std::atomic_size_t sequence;
+    Job* job;
+  };
+
+  void Loop() noexcept;
+  bool Park(bool& spinning) noexcept;
+
+  void StopSpinning() noexcept;
+  void WakeUp() noexcept;
+
+  bool Push(Job& job) noexcept;
+  Job* Pop() noexcept;
+  Job* PopOverflow() noexcept;
+  [[nodiscard]] bool Empty() const noexcept;
+  void DropJobs() noexcept;
+
+  void Stop(std::unique_lock<yaclib_std::mutex>&& lock, std::uint32_t state) noexcept;
+
+  alignas(64) yaclib_std::atomic_size_t _push_pos{0};
+  alignas(64) yaclib_std::atomic_size_t _pop_pos{0};
+  alignas(64) yaclib_std::atomic_uint32_t _state{0};
+  yaclib_std::atomic_uint32_t _running;
+  yaclib_std::atomic_size_t _overflow_count{0};
+
+  std::size_t _mask;
+  std::unique_ptr<Cell[]> _cells;
+  std::uint32_t _count;
+  detail::IdleWorkers _idle_workers;
+  std::vector<yaclib_std::thread> _workers;
+
+  mutable yaclib_std::mutex _m;
+  yaclib_std::condition_variable _idle;
+  detail::List _overflow;
+};
+
+IntrusivePtr<LockFreeThreadPool> MakeLockFreeThreadPool(
+  std::uint64_t threads = yaclib_std::thread::hardware_concurrency(), std::size_t capacity = 4096,
+  std::uint32_t spin_budget = LockFreeThreadPool::kSpinBudget);
+
+}  // namespace yaclib
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <yaclib/exe/executor.hpp>
+#include <yaclib/exe/job.hpp>
+#include <yaclib/util/detail/default_event.hpp>
+#include <yaclib/util/detail/node.hpp>
+
+#include <yaclib_std/atomic>
+#include <yaclib_std/thread>
+
+namespace yaclib {
+
+/**
+ * Event loop executor, it owns one thread and runs jobs strictly in the submission order
+ *
+ * Submit is a lock-free push to the intrusive inbox stack.
+ * Loop takes the whole inbox with one atomic operation and then runs the batch without atomics.
+ * Thread parks on the event only when inbox is empty.
+ */
+class SingleThread : public IExecutor {
+ public:
+  SingleThread();
+
+  ~SingleThread() noexcept override;
+
+  [[nodiscard]] Type Tag() const noexcept final;
+
+  [[nodiscard]] bool Alive() const noexcept final;
+
+  void Submit(Job& job) noexcept final;
+
+  /**
+   * Push the whole list to the inbox with one CAS
+   */
+  void SubmitBatch(detail::List& jobs, std::size_t count) noexcept final;
+
+  /**
+   * Stop when there are no more jobs, including jobs submitted by jobs
+   */
+  void SoftStop() noexcept;
+
+  /**
+   * Stop accepting jobs, already submitted jobs will be called
+   */
+  void Stop() noexcept;
+
+  /**
+   * Stop accepting jobs, already submitted jobs, that loop didn't take yet, will be dropped
+   */
+  void HardStop() noexcept;
+
+  void Wait() noexcept;
+
+ private:
+  void Loop() noexcept;
+  void Park() noexcept;
+  void Stop(bool hard) noexcept;
+  void Push(detail::Node& top, detail::Node& bottom) noexcept;
+
+  yaclib_std::atomic<detail::Node*> _inbox{nullptr};
+  yaclib_std::atomic_bool _want_stop{false};
+  yaclib_std::atomic_bool _stopping{false};
+  bool _hard_stop{false};
+  detail::Node _sleep;
+  detail::Node _stop;
+  detail::DefaultEvent _event;
+  yaclib_std::thread _thread;
+};
+
+IntrusivePtr<SingleThread> MakeSingleThread();
+
+}  // namespace yaclib
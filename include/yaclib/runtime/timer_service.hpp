@@ -0,0 +1,176 @@
+#pragma once
+
+#include <yaclib/async/future.hpp>
+#include <yaclib/exe/executor.hpp>
+#include <yaclib/exe/inline.hpp>
+#include <yaclib/exe/job.hpp>
+#include <yaclib/util/detail/intrusive_list.hpp>
+#include <yaclib/util/detail/node.hpp>
+#include <yaclib/util/intrusive_ptr.hpp>
+
+#if YACLIB_CORO != 0
+#  include <yaclib/coro/coro.hpp>
+#endif
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <yaclib_std/chrono>
+#include <yaclib_std/condition_variable>
+#include <yaclib_std/mutex>
+#include <yaclib_std/thread>
+
+namespace yaclib {
+
+/**
+ * Intrusive timer, it can be embedded in any object, so arming the timer doesn't allocate
+ *
+ * Expired timers are linked to the list of the service by the detail::Node base, so the expiration doesn't allocate too.
+ */
+class TimerNode : public detail::Node {
+ public:
+  static constexpr auto kUnarmed = std::numeric_limits<std::uint32_t>::max();
+
+ private:
+  friend class TimerService;
+
+  TimerNode* _prev = nullptr;
+  TimerNode* _next = nullptr;
+  Job* _job = nullptr;
+  IExecutor* _executor = nullptr;
+  std::uint64_t _deadline = 0;
+  std::uint32_t _slot = kUnarmed;
+};
+
+/**
+ * Timer service backed by the hierarchical timing wheel, it owns one thread
+ *
+ * Arm and Cancel are O(1), expired jobs are submitted to their executors outside of the lock,
+ * jobs with the same executor are submitted by one SubmitBatch call.
+ */
+class TimerService : public IRef {
+ public:
+  using Clock = yaclib_std::chrono::steady_clock;
+
+  explicit TimerService(Clock::duration tick = std::chrono::milliseconds{1});
+
+  ~TimerService() noexcept override;
+
+  /**
+   * Submit job to the executor when deadline expires
+   *
+   * Node, job and executor should be alive until the job is submitted or the timer is cancelled.
+   * If the service is stopped the job will be dropped.
+   */
+  void Arm(TimerNode& node, Job& job, IExecutor& e, Clock::time_point deadline) noexcept;
+
+  /**
+   * Disarm the timer
+   *
+   * \return false if the timer already expired or wasn't armed, so the job is or will be submitted
+   */
+  bool Cancel(TimerNode& node) noexcept;
+
+  /**
+   * \return \ref FutureOn which will be ready on the executor e when deadline expires
+   */
+  [[nodiscard]] FutureOn<> ScheduleAt(IExecutor& e, Clock::time_point deadline);
+
+  template <typename Rep, typename Period>
+  [[nodiscard]] FutureOn<> ScheduleAfter(IExecutor& e, const std::chrono::duration<Rep, Period>& duration) {
+    return ScheduleAt(e, Clock::now() + std::chrono::ceil<Clock::duration>(duration));
+  }
+
+  /**
+   * \return \ref Future which will be ready on the timer thread when deadline expires
+   */
+  [[nodiscard]] Future<> ScheduleAt(Clock::time_point deadline) {
+    return ScheduleAt(MakeInline(), deadline).On(nullptr);
+  }
+
+  template <typename Rep, typename Period>
+  [[nodiscard]] Future<> ScheduleAfter(const std::chrono::duration<Rep, Period>& duration) {
+    return ScheduleAfter(MakeInline(), duration).On(nullptr);
+  }
+
+#if YACLIB_CORO != 0
+ private:
+  class [[nodiscard]] SleepAwaiter final : public TimerNode {
+   public:
+    SleepAwaiter(TimerService& service, Clock::time_point deadline) noexcept : _service{service}, _deadline{deadline} {
+    }
+
+    YACLIB_INLINE bool await_ready() const noexcept {
+      return _deadline <= Clock::now();
+    }
+
+    template <typename Promise>
+    YACLIB_INLINE void await_suspend(yaclib_std::coroutine_handle<Promise> handle) noexcept {
+      auto& promise = handle.promise();
+      YACLIB_ASSERT(promise._executor != nullptr);
+      _service.Arm(*this, promise, *promise._executor, _deadline);
+    }
+
+    constexpr void await_resume() const noexcept {
+    }
+
+   private:
+    TimerService& _service;
+    Clock::time_point _deadline;
+  };
+
+ public:
+  /**
+   * co_await until deadline, coroutine will be resumed on its executor
+   */
+  YACLIB_INLINE SleepAwaiter SleepUntil(Clock::time_point deadline) noexcept {
+    return SleepAwaiter{*this, deadline};
+  }
+
+  template <typename Rep, typename Period>
+  YACLIB_INLINE SleepAwaiter SleepFor(const std::chrono::duration<Rep, Period>& duration) noexcept {
+    return SleepAwaiter{*this, Clock::now() + std::chrono::ceil<Clock::duration>(duration)};
+  }
+#endif
+
+  /**
+   * Stop the thread, armed timers will be dropped
+   */
+  void Stop() noexcept;
+
+  void Wait() noexcept;
+
+ private:
+  static constexpr std::uint32_t kBits = 6;
+  static constexpr std::uint32_t kSlots = 1U << kBits;
+  // 11 levels of 64 slots cover all 64-bit ticks, so deadlines never wrap around the wheel
+  static constexpr std::uint32_t kLevels = (64 + kBits - 1) / kBits;
+
+  void Loop() noexcept;
+  void Link(TimerNode& node) noexcept;
+  void Unlink(TimerNode& node) noexcept;
+  [[nodiscard]] bool Next(std::uint64_t& at, std::uint32_t& slot) const noexcept;
+  void Process(std::uint64_t at, std::uint32_t slot) noexcept;
+  static void Dispatch(detail::List& expired) noexcept;
+  [[nodiscard]] std::uint64_t Ticks(Clock::time_point time, bool ceil) const noexcept;
+
+  std::array<std::uint64_t, kLevels> _occupied{};
+  std::array<TimerNode*, std::size_t{kLevels} * kSlots> _slots{};
+  detail::List _expired;
+  Clock::time_point _start;
+  Clock::duration _tick;
+  std::uint64_t _max_wait;
+  std::uint64_t _now = 0;
+  std::uint64_t _wake_at = std::numeric_limits<std::uint64_t>::max();
+  bool _stop = false;
+  yaclib_std::mutex _m;
+  yaclib_std::condition_variable _cv;
+  yaclib_std::thread _thread;
+};
+
+IntrusivePtr<TimerService> MakeTimerService(TimerService::Clock::duration tick = std::chrono::milliseconds{1});
+
+}  // namespace yaclib
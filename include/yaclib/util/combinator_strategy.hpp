@@ -40,6 +40,10 @@ enum class CorePolicy {
   Managed,
 };
 
+// Strategy can also have
+// bool StopRequested() const noexcept;
+// If it returns true, not started callbacks of the inputs are skipped, see Future::Cancel
+
 // The related code is located in async/when/when.hpp
 
 }  // namespace yaclib
@@ -2,6 +2,8 @@
 
 #include <yaclib/util/detail/node.hpp>
 
+#include <utility>
+
 namespace yaclib::detail {
 
 class List final {
@@ -15,10 +17,22 @@ class List final {
 
   void PushFront(Node& node) noexcept;
   void PushBack(Node& node) noexcept;
+  /**
+   * Move all nodes of other to the end of this list in O(1), other will be empty
+   */
+  void PushBack(List&& other) noexcept;
 
   [[nodiscard]] bool Empty() const noexcept;
   [[nodiscard]] Node& PopFront() noexcept;
 
+  /**
+   * Take all nodes linked in the reversed order, so they can be pushed on an intrusive stack with one CAS
+   *
+   * List should be non empty, it will be empty.
+   * \return top, the last node, and bottom, the first node, bottom's next isn't changed
+   */
+  [[nodiscard]] std::pair<Node*, Node*> PopAllReversed() noexcept;
+
  private:
   Node _head;
   Node* _tail = &_head;  // need for PushBack
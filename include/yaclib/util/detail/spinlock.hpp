@@ -15,6 +15,10 @@ class Spinlock {
     }
   }
 
+  [[nodiscard]] bool try_lock() noexcept {
+    return _state.load(std::memory_order_relaxed) == 0 && _state.exchange(1, std::memory_order_acquire) == 0;
+  }
+
   void unlock() noexcept {
     _state.store(0, std::memory_order_release);
   }
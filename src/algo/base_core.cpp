@@ -1,12 +1,141 @@
 #include <yaclib/algo/detail/base_core.hpp>
 
+#include <yaclib_std/thread>
+
 namespace yaclib::detail {
+namespace {
+
+YACLIB_INLINE InlineCore* Pointer(std::uintptr_t callback) noexcept {
+  return reinterpret_cast<InlineCore*>(callback & ~BaseCore::kFlags);
+}
+
+// Completion can't overtake the walk, otherwise the walk could touch the already destroyed producer
+YACLIB_INLINE std::uintptr_t WaitWalk(const yaclib_std::atomic_uintptr_t& word, std::uintptr_t callback) noexcept {
+  while (callback != BaseCore::kResult && (callback & BaseCore::kStopMask) == BaseCore::kWalking) {
+    yaclib_std::this_thread::yield();
+    callback = word.load(std::memory_order_acquire);
+  }
+  return callback;
+}
+
+}  // namespace
+
+bool BaseCore::AskStop(std::uintptr_t callback) const noexcept {
+  // Callback can't be destroyed until this core has a result, so it's safe to go down the chain
+  bool stop = false;
+  const InlineCore* core = Pointer(callback);
+  while (core != nullptr) {
+    core = core->StopNext(stop);
+  }
+  return stop;
+}
+
+const InlineCore* BaseCore::StopNext(bool& stop) const noexcept {
+  const auto callback = _callback.load(std::memory_order_acquire);
+  const auto mark = callback & kStopMask;
+  stop = callback != kResult && mark == kStopped;
+  if (callback == kResult || mark == kNoStop || mark == kStopped) {
+    return nullptr;
+  }
+  return Pointer(callback);
+}
+
+void BaseCore::Walk(Stop stop, Job* job) noexcept {
+  // Only the owner of the last future in the chain starts the walk, so the walks of the single chain don't overlap,
+  // but the core can be held by itself, when it replaces its producer
+  auto* top = this;
+  while (auto* producer = top->Producer()) {
+    auto callback = producer->_callback.load(std::memory_order_acquire);
+    bool marked = false;
+    do {
+      callback = WaitWalk(producer->_callback, callback);
+      YACLIB_ASSERT(callback == kResult || Pointer(callback) == top);
+      const auto mark = callback & kStopMask;
+      if (callback == kResult || mark == kStopped || mark == stop) {
+        break;
+      }
+      auto walking = callback | kWalking;
+      if (stop == kStopped) {
+        walking &= ~kSubscribed;
+      }
+      marked = producer->_callback.compare_exchange_weak(callback, walking, std::memory_order_acq_rel,
+                                                         std::memory_order_acquire);
+    } while (!marked);
+    if (!marked) {
+      break;
+    }
+    if (stop == kStopped && (callback & kSubscribed) != 0) {
+      YACLIB_ASSERT(job == nullptr);
+      job = static_cast<Job*>(producer->next);
+    }
+    top = producer;
+  }
+  // From the top, so every producer has its final mark before its callback can complete
+  for (auto* core = top;;) {
+    auto callback = core->_callback.load(std::memory_order_relaxed);
+    while (!core->_callback.compare_exchange_weak(callback, (callback & ~kStopMask) | stop, std::memory_order_release,
+                                                  std::memory_order_relaxed)) {
+    }
+    if (core == this) {
+      break;
+    }
+    core = static_cast<BaseCore*>(Pointer(callback));
+  }
+  if (job != nullptr) {
+    job->Call();
+  }
+}
+
+void BaseCore::PushStop() noexcept {
+  auto expected = _callback.load(std::memory_order_acquire);
+  do {
+    expected = WaitWalk(_callback, expected);
+    if (expected == kResult || (expected & kStopMask) == kStopped) {
+      return;
+    }
+  } while (!_callback.compare_exchange_weak(expected, (expected | kWalking) & ~kSubscribed, std::memory_order_acq_rel,
+                                            std::memory_order_acquire));
+  Walk(kStopped, (expected & kSubscribed) != 0 ? static_cast<Job*>(next) : nullptr);
+}
+
+BaseCore::Stop BaseCore::HoldImpl() noexcept {
+  auto expected = _callback.load(std::memory_order_acquire);
+  do {
+    expected = WaitWalk(_callback, expected);
+    YACLIB_ASSERT(expected != kResult);
+  } while (!_callback.compare_exchange_weak(expected, expected | kWalking, std::memory_order_acq_rel,
+                                            std::memory_order_acquire));
+  return static_cast<Stop>(expected & kStopMask);
+}
+
+void BaseCore::UnholdImpl(Stop stop, BaseCore* producer) noexcept {
+  // Only the stop request goes to the new producer, asking the callback through the recursive async results is too long
+  if (producer != nullptr && stop == kStopped) {
+    producer->PushStop();
+  }
+  auto callback = _callback.load(std::memory_order_relaxed);
+  while (!_callback.compare_exchange_weak(callback, (callback & ~kStopMask) | stop, std::memory_order_release,
+                                          std::memory_order_relaxed)) {
+  }
+}
+
+void BaseCore::StoreCallbackImpl(InlineCore& callback, Stop stop) noexcept {
+  // Chain isn't started yet, so nobody else can touch it
+  const auto pointer = reinterpret_cast<std::uintptr_t>(&callback);
+  if (stop == kAskStop && Producer() != nullptr) {
+    _callback.store(pointer | kWalking, std::memory_order_relaxed);
+    Walk(stop, nullptr);
+  } else {
+    _callback.store(pointer | stop, std::memory_order_relaxed);
+  }
+}
 
 template <bool Shared>
-[[nodiscard]] bool BaseCore::SetCallbackImpl(InlineCore& callback) noexcept {
+[[nodiscard]] bool BaseCore::SetCallbackImpl(InlineCore& callback, Stop stop) noexcept {
   YACLIB_ASSERT(reinterpret_cast<std::uintptr_t>(&callback) != kEmpty);
   YACLIB_ASSERT(reinterpret_cast<std::uintptr_t>(&callback) != kResult);
   if constexpr (Shared) {
+    // Result of the shared core is always needed, so the stop isn't stored
     auto next = _callback.load(std::memory_order_acquire);
     do {
       if (next == kResult) {
@@ -17,43 +146,116 @@ template <bool Shared>
                                               std::memory_order_release, std::memory_order_acquire));
     return true;
   } else {
-    std::uintptr_t expected = kEmpty;
-    return _callback.load(std::memory_order_acquire) == expected &&
-           _callback.compare_exchange_strong(expected, reinterpret_cast<std::uintptr_t>(&callback),
-                                             std::memory_order_release, std::memory_order_acquire);
+    const bool walk = stop == kAskStop && Producer() != nullptr;
+    const auto pointer = reinterpret_cast<std::uintptr_t>(&callback) | (walk ? kWalking : stop);
+    auto expected = _callback.load(std::memory_order_acquire);
+    do {
+      expected = WaitWalk(_callback, expected);
+      if (expected == kResult) {
+        return false;
+      }
+      YACLIB_ASSERT((expected & ~kSubscribed) == kEmpty);
+    } while (!_callback.compare_exchange_weak(expected, pointer | (expected & kSubscribed), std::memory_order_release,
+                                              std::memory_order_acquire));
+    if (walk) {
+      Walk(stop, nullptr);
+    }
+    return true;
   }
 }
 
-template bool BaseCore::SetCallbackImpl<false>(InlineCore&) noexcept;
-template bool BaseCore::SetCallbackImpl<true>(InlineCore&) noexcept;
+template bool BaseCore::SetCallbackImpl<false>(InlineCore&, Stop) noexcept;
+template bool BaseCore::SetCallbackImpl<true>(InlineCore&, Stop) noexcept;
 
 [[nodiscard]] bool BaseCore::ResetImpl() noexcept {
   // Resetting a callback is not supported in shared cores
-  auto expected = _callback.load(std::memory_order_relaxed);
-  return expected != kResult && _callback.compare_exchange_strong(expected, kEmpty, std::memory_order_relaxed);
+  auto expected = WaitWalk(_callback, _callback.load(std::memory_order_acquire));
+  return expected != kResult &&
+         _callback.compare_exchange_strong(expected, expected & kSubscribed, std::memory_order_relaxed);
+}
+
+void BaseCore::CancelImpl() noexcept {
+  auto& stop = MakeStop();
+  auto expected = _callback.load(std::memory_order_acquire);
+  do {
+    expected = WaitWalk(_callback, expected);
+    if (expected == kResult) {
+      [[maybe_unused]] auto* next = stop.Here(*this);
+      YACLIB_ASSERT(next == nullptr);
+      return;
+    }
+    YACLIB_ASSERT((expected & ~kSubscribed) == kEmpty);
+  } while (!_callback.compare_exchange_weak(expected, reinterpret_cast<std::uintptr_t>(&stop) | kWalking,
+                                            std::memory_order_acq_rel, std::memory_order_acquire));
+  Walk(kStopped, (expected & kSubscribed) != 0 ? static_cast<Job*>(next) : nullptr);
+}
+
+void BaseCore::SubscribeImpl(Job& job) noexcept {
+  if (StopRequested()) {
+    job.Call();
+    return;
+  }
+  next = &job;
+  auto expected = _callback.load(std::memory_order_acquire);
+  do {
+    // The walk doesn't see the job, so wait for its end
+    expected = WaitWalk(_callback, expected);
+    YACLIB_ASSERT(expected != kResult);
+    YACLIB_ASSERT((expected & kSubscribed) == 0);
+    if ((expected & kStopMask) == kStopped) {
+      job.Call();
+      return;
+    }
+  } while (!_callback.compare_exchange_weak(expected, expected | kSubscribed, std::memory_order_acq_rel,
+                                            std::memory_order_acquire));
+}
+
+void BaseCore::UnsubscribeImpl() noexcept {
+  auto expected = _callback.load(std::memory_order_acquire);
+  do {
+    expected = WaitWalk(_callback, expected);
+    if (expected == kResult || (expected & kSubscribed) == 0) {
+      return;
+    }
+  } while (!_callback.compare_exchange_weak(expected, expected & ~kSubscribed, std::memory_order_acq_rel,
+                                            std::memory_order_acquire));
+  static_cast<Job*>(next)->Drop();
 }
 
 template <bool SymmetricTransfer, bool Shared>
-[[nodiscard]] Transfer<SymmetricTransfer> BaseCore::SetInlineImpl(InlineCore& callback) noexcept {
-  if (!SetCallbackImpl<Shared>(callback)) {
+[[nodiscard]] Transfer<SymmetricTransfer> BaseCore::SetInlineImpl(InlineCore& callback, Stop stop) noexcept {
+  if (!SetCallbackImpl<Shared>(callback, stop)) {
     return Step<SymmetricTransfer>(*this, callback);
   }
   return Noop<SymmetricTransfer>();
 }
 
-template Transfer<false> BaseCore::SetInlineImpl<false, false>(InlineCore&) noexcept;
-template Transfer<false> BaseCore::SetInlineImpl<false, true>(InlineCore&) noexcept;
+template Transfer<false> BaseCore::SetInlineImpl<false, false>(InlineCore&, Stop) noexcept;
+template Transfer<false> BaseCore::SetInlineImpl<false, true>(InlineCore&, Stop) noexcept;
 
 #if YACLIB_SYMMETRIC_TRANSFER != 0
-template Transfer<true> BaseCore::SetInlineImpl<true, false>(InlineCore&) noexcept;
-template Transfer<true> BaseCore::SetInlineImpl<true, true>(InlineCore&) noexcept;
+template Transfer<true> BaseCore::SetInlineImpl<true, false>(InlineCore&, Stop) noexcept;
+template Transfer<true> BaseCore::SetInlineImpl<true, true>(InlineCore&, Stop) noexcept;
 #endif
 
+InlineCore* BaseCore::PublishImpl() noexcept {
+  auto expected = _callback.load(std::memory_order_acquire);
+  do {
+    expected = WaitWalk(_callback, expected);
+    YACLIB_ASSERT(expected != kResult);
+  } while (!_callback.compare_exchange_weak(expected, kResult, std::memory_order_acq_rel, std::memory_order_acquire));
+  if ((expected & kSubscribed) != 0) {
+    // Result is set without the stop request
+    static_cast<Job*>(next)->Drop();
+  }
+  return Pointer(expected);
+}
+
 template <bool SymmetricTransfer, bool Shared>
 [[nodiscard]] Transfer<SymmetricTransfer> BaseCore::SetResultImpl() noexcept {
-  const auto expected = _callback.exchange(kResult, std::memory_order_acq_rel);
-  YACLIB_ASSERT(expected != kResult);
   if constexpr (Shared) {
+    const auto expected = _callback.exchange(kResult, std::memory_order_acq_rel);
+    YACLIB_ASSERT(expected != kResult);
     auto* head = reinterpret_cast<InlineCore*>(expected);
     if (head) {
       while (auto* next = head->next) {
@@ -71,8 +273,7 @@ template <bool SymmetricTransfer, bool Shared>
     DecRef();
     return Noop<SymmetricTransfer>();
   } else {
-    if (expected != kEmpty) {
-      auto* const callback = reinterpret_cast<InlineCore*>(expected);
+    if (auto* const callback = PublishImpl()) {
       return Step<SymmetricTransfer>(*this, *callback);
     } else {
       return Noop<SymmetricTransfer>();
@@ -20,7 +20,28 @@ class Drop final : public InlineCore {
 #endif
 };
 
+class Stop final : public InlineCore {
+  template <bool SymmetricTransfer>
+  [[nodiscard]] YACLIB_INLINE auto Impl(InlineCore& caller) noexcept {
+    caller.DecRef();
+    return Noop<SymmetricTransfer>();
+  }
+  [[nodiscard]] InlineCore* Here(InlineCore& caller) noexcept final {
+    return Impl<false>(caller);
+  }
+#if YACLIB_SYMMETRIC_TRANSFER != 0
+  [[nodiscard]] yaclib_std::coroutine_handle<> Next(InlineCore& caller) noexcept final {
+    return Impl<true>(caller);
+  }
+#endif
+  [[nodiscard]] const InlineCore* StopNext(bool& stop) const noexcept final {
+    stop = true;
+    return nullptr;
+  }
+};
+
 static Drop kDropCore;
+static Stop kStopCore;
 
 }  // namespace
 
@@ -28,4 +49,8 @@ InlineCore& MakeDrop() noexcept {
   return kDropCore;
 }
 
+InlineCore& MakeStop() noexcept {
+  return kStopCore;
+}
+
 }  // namespace yaclib::detail
@@ -1,25 +1,42 @@
 #include <yaclib/algo/one_shot_event.hpp>
+#include <yaclib/coro/detail/resume.hpp>
+#include <yaclib/util/detail/intrusive_list.hpp>
 
 namespace yaclib {
 namespace {
 
-void SetImpl(yaclib_std::atomic_uintptr_t& self, std::uintptr_t value) {
+void SetImpl(yaclib_std::atomic_uintptr_t& self, std::uintptr_t value, std::uintptr_t submit) {
   auto head = self.exchange(value, std::memory_order_acq_rel);
-  auto* job = reinterpret_cast<Job*>(head);
-  while (job != nullptr) {
-    auto* next = static_cast<Job*>(job->next);
-    job->Call();
-    job = next;
+  // Awaiters which need the submit usually wait on the same executor, so they're submitted by batches
+  detail::List cores;
+  while (head != 0) {
+    auto* job = reinterpret_cast<Job*>(head & ~submit);
+    const auto next = reinterpret_cast<std::uintptr_t>(job->next);
+    if ((head & submit) != 0) {
+      cores.PushBack(*job);
+    } else {
+      job->Call();
+    }
+    head = next;
   }
+  detail::ResumeBatch(cores);
 }
 
 }  // namespace
 
 bool OneShotEvent::TryAdd(Job& job) noexcept {
+  return TryAddImpl(job, reinterpret_cast<std::uintptr_t>(&job));
+}
+
+bool OneShotEvent::TryAddSubmit(detail::BaseCore& core) noexcept {
+  return TryAddImpl(core, reinterpret_cast<std::uintptr_t>(static_cast<Job*>(&core)) | kSubmit);
+}
+
+bool OneShotEvent::TryAddImpl(Job& job, std::uintptr_t node) noexcept {
   auto head = _head.load(std::memory_order_acquire);
-  auto node = reinterpret_cast<std::uintptr_t>(&job);
   while (head != OneShotEvent::kAllDone) {
-    job.next = reinterpret_cast<Job*>(head);
+    // Head can be tagged, so it's stored as is, without the conversion to Node
+    job.next = reinterpret_cast<detail::Node*>(head);
     if (_head.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_acquire)) {
       return true;
     }
@@ -40,11 +57,11 @@ void OneShotEvent::Wait() noexcept {
 }
 
 void OneShotEvent::Call() noexcept {
-  SetImpl(_head, kEmpty);
+  SetImpl(_head, kEmpty, kSubmit);
 }
 
 void OneShotEvent::Set() noexcept {
-  SetImpl(_head, kAllDone);
+  SetImpl(_head, kAllDone, kSubmit);
 }
 
 void OneShotEvent::Reset() noexcept {
@@ -0,0 +1,12 @@
+#include <yaclib/exe/executor.hpp>
+
+namespace yaclib {
+
+void IExecutor::SubmitBatch(detail::List& jobs, std::size_t /*count*/) noexcept {
+  while (!jobs.Empty()) {
+    auto& job = jobs.PopFront();
+    Submit(static_cast<Job&>(job));
+  }
+}
+
+}  // namespace yaclib
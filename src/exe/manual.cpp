@@ -1,6 +1,8 @@
 #include <yaclib/exe/manual.hpp>
 #include <yaclib/util/helper.hpp>
 
+#include <utility>
+
 namespace yaclib {
 
 IExecutor::Type ManualExecutor::Tag() const noexcept {
@@ -15,6 +17,10 @@ void ManualExecutor::Submit(Job& f) noexcept {
   _tasks.PushBack(f);
 }
 
+void ManualExecutor::SubmitBatch(detail::List& jobs, std::size_t /*count*/) noexcept {
+  _tasks.PushBack(std::move(jobs));
+}
+
 std::size_t ManualExecutor::Drain() noexcept {
   std::size_t done = 0;
   while (!_tasks.Empty()) {
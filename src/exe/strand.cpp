@@ -22,10 +22,23 @@ bool Strand::Alive() const noexcept {
 }
 
 void Strand::Submit(Job& job) noexcept {
+  Push(job, job);
+}
+
+void Strand::SubmitBatch(detail::List& jobs, std::size_t /*count*/) noexcept {
+  if (jobs.Empty()) {
+    return;
+  }
+  // _jobs is a stack, so the batch is linked in the reversed order and pushed with one CAS
+  auto [top, bottom] = jobs.PopAllReversed();
+  Push(*top, *bottom);
+}
+
+void Strand::Push(Node& top, Node& bottom) noexcept {
   auto* expected = _jobs.load(std::memory_order_relaxed);
   do {
-    job.next = expected == Mark() ? nullptr : expected;
-  } while (!_jobs.compare_exchange_weak(expected, &job, std::memory_order_acq_rel, std::memory_order_relaxed));
+    bottom.next = expected == Mark() ? nullptr : expected;
+  } while (!_jobs.compare_exchange_weak(expected, &top, std::memory_order_acq_rel, std::memory_order_relaxed));
   if (expected == Mark()) {
     static_cast<Job&>(*this).IncRef();
     _executor->Submit(*this);
@@ -1,9 +1,12 @@
 #include <yaclib/runtime/fair_thread_pool.hpp>
 #include <yaclib/util/helper.hpp>
 
+#include <utility>
+
 namespace yaclib {
 
-FairThreadPool::FairThreadPool(std::uint64_t threads) : _jobs_count{0} {
+FairThreadPool::FairThreadPool(std::uint64_t threads, std::uint32_t spin_budget)
+    : _idle_workers{static_cast<std::uint32_t>(threads), spin_budget}, _jobs_count{0} {
   _workers.reserve(threads);
   for (std::uint64_t i = 0; i != threads; ++i) {
     _workers.emplace_back([&] {
@@ -34,8 +37,30 @@ void FairThreadPool::Submit(Job& job) noexcept {
   }
   _jobs.PushBack(job);
   _jobs_count += 4;  // Add Job
+  _queued.store(_queued.load(std::memory_order_relaxed) + 1, std::memory_order_seq_cst);
   lock.unlock();
-  _idle.notify_one();
+  WakeUp();
+}
+
+void FairThreadPool::SubmitBatch(detail::List& jobs, std::size_t count) noexcept {
+  if (count == 0) {
+    return;
+  }
+  std::unique_lock lock{_m};
+  if (WasStop()) {
+    lock.unlock();
+    while (!jobs.Empty()) {
+      auto& job = jobs.PopFront();
+      static_cast<Job&>(job).Drop();
+    }
+    return;
+  }
+  _jobs.PushBack(std::move(jobs));
+  _jobs_count += 4 * count;  // Add Jobs
+  _queued.store(_queued.load(std::memory_order_relaxed) + count, std::memory_order_seq_cst);
+  lock.unlock();
+  // Woken worker is accounted as spinner, when it takes a job StopSpinning wakes up the next one for the rest
+  WakeUp();
 }
 
 void FairThreadPool::SoftStop() noexcept {
@@ -54,6 +79,7 @@ void FairThreadPool::Stop() noexcept {
 void FairThreadPool::HardStop() noexcept {
   std::unique_lock lock{_m};
   detail::List jobs{std::move(_jobs)};
+  _queued.store(0, std::memory_order_relaxed);
   Stop(std::move(lock));
   while (!jobs.Empty()) {
     auto& job = jobs.PopFront();
@@ -69,11 +95,19 @@ void FairThreadPool::Wait() noexcept {
 }
 
 void FairThreadPool::Loop() noexcept {
+  bool spinning = false;
+  bool spun = false;
   std::unique_lock lock{_m};
   while (true) {
     while (!_jobs.Empty()) {
       auto& job = _jobs.PopFront();
+      _queued.store(_queued.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
       lock.unlock();
+      if (spinning) {
+        spinning = false;
+        StopSpinning();
+      }
+      spun = false;
       static_cast<Job&>(job).Call();
       lock.lock();
       _jobs_count -= 4;  // Pop job
@@ -84,7 +118,29 @@ void FairThreadPool::Loop() noexcept {
     if (WasStop()) {
       return;
     }
+    if (!spinning && !spun) {
+      spinning = _idle_workers.StartSpinning();
+    }
+    if (spinning) {
+      lock.unlock();
+      const bool found = _idle_workers.Spin([&] {
+        return _queued.load(std::memory_order_relaxed) != 0;
+      });
+      lock.lock();
+      // Submit skipped notify while we were spinning, so before park we recheck jobs under the lock
+      if (!found || _jobs.Empty()) {
+        spinning = false;
+        spun = true;
+        _idle_workers.CancelSpinning();
+      }
+      continue;
+    }
+    spun = false;
+    _idle_workers.Park();
     _idle.wait(lock);
+    _idle_workers.Unpark();
+    // WakeUp already accounted us as spinner
+    spinning = _idle_workers.Woken();
   }
 }
 
@@ -106,8 +162,20 @@ void FairThreadPool::Stop(std::unique_lock<yaclib_std::mutex>&& lock) noexcept {
   _idle.notify_all();
 }
 
-IntrusivePtr<FairThreadPool> MakeFairThreadPool(std::uint64_t threads) {
-  return MakeShared<FairThreadPool>(1, threads);
+void FairThreadPool::StopSpinning() noexcept {
+  // The last spinner found a job, so if there are more jobs someone else should look for them
+  if (_idle_workers.StopSpinning() && _queued.load(std::memory_order_seq_cst) != 0) {
+    WakeUp();
+  }
+}
+
+void FairThreadPool::WakeUp() noexcept {
+  // Submit pushes job and then checks sleeping workers, worker parks and then checks jobs under the same lock
+  _idle_workers.WakeUp(_m, _idle);
+}
+
+IntrusivePtr<FairThreadPool> MakeFairThreadPool(std::uint64_t threads, std::uint32_t spin_budget) {
+  return MakeShared<FairThreadPool>(1, threads, spin_budget);
 }
 
 }  // namespace yaclib
@@ -0,0 +1,441 @@
+#include <yaclib/log.hpp>
+#include <yaclib/runtime/golang_thread_pool.hpp>
+#include <yaclib/util/helper.hpp>
+
+#include <algorithm>
+#include <utility>
+#include <yaclib_std/thread_local>
+
+namespace yaclib {
+namespace detail {
+
+/**
+ * Bounded single producer multiple consumer queue, plus LIFO slot for the next job
+ *
+ * Push and Pop called only by the owner, Grab called by the thief on its own queue, to steal half of the victim queue
+ */
+struct alignas(64) GolangWorker final {
+  static constexpr std::uint32_t kSize = 256;
+
+  bool Push(Job& job) noexcept {
+    const auto head = _head.load(std::memory_order_acquire);
+    const auto tail = _tail.load(std::memory_order_relaxed);
+    if (tail - head >= kSize) {
+      return false;
+    }
+    _jobs[tail % kSize].store(&job, std::memory_order_relaxed);
+    _tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  Job* Pop() noexcept {
+    auto head = _head.load(std::memory_order_acquire);
+    while (true) {
+      const auto tail = _tail.load(std::memory_order_relaxed);
+      if (head == tail) {
+        return nullptr;
+      }
+      auto* job = _jobs[head % kSize].load(std::memory_order_relaxed);
+      if (_head.compare_exchange_weak(head, head + 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        return job;
+      }
+    }
+  }
+
+  /**
+   * Move half of the local queue and the job to the list, if it failed, there is a free space in the local queue now
+   */
+  bool Spill(Job& job, List& jobs, std::uint32_t& count) noexcept {
+    auto head = _head.load(std::memory_order_acquire);
+    const auto tail = _tail.load(std::memory_order_relaxed);
+    const auto n = (tail - head) / 2;
+    if (n == 0 || n > kSize / 2) {
+      return false;
+    }
+    Job* batch[kSize / 2];
+    for (std::uint32_t i = 0; i != n; ++i) {
+      batch[i] = _jobs[(head + i) % kSize].load(std::memory_order_relaxed);
+    }
+    if (!_head.compare_exchange_strong(head, head + n, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+      return false;
+    }
+    for (std::uint32_t i = 0; i != n; ++i) {
+      jobs.PushBack(*batch[i]);
+    }
+    jobs.PushBack(job);
+    count = n + 1;
+    return true;
+  }
+
+  Job* Grab(GolangWorker& victim) noexcept {
+    auto head = victim._head.load(std::memory_order_acquire);
+    while (true) {
+      const auto tail = victim._tail.load(std::memory_order_acquire);
+      auto n = tail - head;
+      n -= n / 2;
+      if (n == 0) {
+        if (victim._next.load(std::memory_order_relaxed) == nullptr) {
+          return nullptr;
+        }
+        return victim._next.exchange(nullptr, std::memory_order_acq_rel);
+      }
+      if (n > kSize / 2) {  // inconsistent head and tail
+        head = victim._head.load(std::memory_order_acquire);
+        continue;
+      }
+      const auto my_tail = _tail.load(std::memory_order_relaxed);
+      for (std::uint32_t i = 0; i != n; ++i) {
+        auto* job = victim._jobs[(head + i) % kSize].load(std::memory_order_relaxed);
+        _jobs[(my_tail + i) % kSize].store(job, std::memory_order_relaxed);
+      }
+      if (victim._head.compare_exchange_weak(head, head + n, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        --n;
+        auto* job = _jobs[(my_tail + n) % kSize].load(std::memory_order_relaxed);
+        if (n != 0) {
+          _tail.store(my_tail + n, std::memory_order_release);
+        }
+        return job;
+      }
+    }
+  }
+
+  [[nodiscard]] bool Empty() const noexcept {
+    return _next.load(std::memory_order_seq_cst) == nullptr &&
+           _head.load(std::memory_order_seq_cst) == _tail.load(std::memory_order_seq_cst);
+  }
+
+  std::uint32_t Random() noexcept {
+    auto x = _random;
+    x ^= x << 13U;
+    x ^= x >> 17U;
+    x ^= x << 5U;
+    return _random = x;
+  }
+
+  GolangThreadPool* _pool = nullptr;
+  std::uint32_t _random = 0;
+  std::uint32_t _tick = 0;
+  std::uint32_t _next_in_row = 0;
+  yaclib_std::atomic<Job*> _next{nullptr};
+  yaclib_std::atomic_uint32_t _head{0};
+  yaclib_std::atomic_uint32_t _tail{0};
+  yaclib_std::atomic<Job*> _jobs[kSize];
+};
+
+}  // namespace detail
+namespace {
+
+constexpr std::uint32_t kStopped = 1U;
+constexpr std::uint32_t kWantStop = 2U;
+constexpr std::uint32_t kHardStop = 4U;
+
+// Prime, same as in the golang runtime, to avoid synchronization with the period of the user code
+constexpr std::uint32_t kGlobalPeriod = 61;
+// Two jobs which submit each other can't starve the local queue
+constexpr std::uint32_t kNextLimit = 8;
+constexpr std::uint32_t kStealRounds = 4;
+
+YACLIB_THREAD_LOCAL_PTR(detail::GolangWorker) tls_worker;
+
+}  // namespace
+
+GolangThreadPool::GolangThreadPool(std::uint64_t threads)
+    : _count{static_cast<std::uint32_t>(threads)}, _local{std::make_unique<Worker[]>(threads)} {
+  _workers.reserve(threads);
+  for (std::uint32_t i = 0; i != _count; ++i) {
+    auto& worker = _local[i];
+    worker._pool = this;
+    worker._random = 0x9E3779B9U * (i + 1);
+    _workers.emplace_back([this, &worker] {
+      Loop(worker);
+    });
+  }
+}
+
+GolangThreadPool::~GolangThreadPool() noexcept {
+  YACLIB_DEBUG(!_workers.empty(), "You need explicitly join ThreadPool");
+}
+
+IExecutor::Type GolangThreadPool::Tag() const noexcept {
+  return Type::GolangThreadPool;
+}
+
+bool GolangThreadPool::Alive() const noexcept {
+  return (_state.load(std::memory_order_acquire) & kStopped) == 0;
+}
+
+void GolangThreadPool::Submit(Job& job) noexcept {
+  if (tls_worker != nullptr && tls_worker->_pool == this) {
+    if ((_state.load(std::memory_order_relaxed) & kStopped) != 0) {
+      return job.Drop();
+    }
+    auto& worker = *tls_worker;
+    auto* prev = worker._next.exchange(&job, std::memory_order_seq_cst);
+    if (prev != nullptr) {
+      detail::List jobs;
+      std::uint32_t count = 0;
+      while (!worker.Push(*prev)) {
+        if (worker.Spill(*prev, jobs, count)) {
+          PushGlobal(jobs, count);
+          break;
+        }
+      }
+    }
+    return WakeUp();
+  }
+  std::unique_lock lock{_m};
+  if ((_state.load(std::memory_order_relaxed) & kStopped) != 0) {
+    lock.unlock();
+    return job.Drop();
+  }
+  _global.PushBack(job);
+  _global_count.store(_global_count.load(std::memory_order_relaxed) + 1, std::memory_order_seq_cst);
+  lock.unlock();
+  WakeUp();
+}
+
+void GolangThreadPool::SubmitBatch(detail::List& jobs, std::size_t count) noexcept {
+  if (count == 0) {
+    return;
+  }
+  std::unique_lock lock{_m};
+  if ((_state.load(std::memory_order_relaxed) & kStopped) != 0) {
+    lock.unlock();
+    while (!jobs.Empty()) {
+      auto& job = jobs.PopFront();
+      static_cast<Job&>(job).Drop();
+    }
+    return;
+  }
+  _global.PushBack(std::move(jobs));
+  _global_count.store(_global_count.load(std::memory_order_relaxed) + count, std::memory_order_seq_cst);
+  lock.unlock();
+  WakeUp();
+}
+
+void GolangThreadPool::SoftStop() noexcept {
+  std::unique_lock lock{_m};
+  if (_sleeping.load(std::memory_order_relaxed) == _count && _global_count.load(std::memory_order_relaxed) == 0) {
+    Stop(std::move(lock), kStopped);
+  } else {
+    _state.fetch_or(kWantStop, std::memory_order_relaxed);
+  }
+}
+
+void GolangThreadPool::Stop() noexcept {
+  Stop(std::unique_lock{_m}, kStopped);
+}
+
+void GolangThreadPool::HardStop() noexcept {
+  std::unique_lock lock{_m};
+  detail::List jobs{std::move(_global)};
+  _global_count.store(0, std::memory_order_relaxed);
+  Stop(std::move(lock), kStopped | kHardStop);
+  while (!jobs.Empty()) {
+    auto& job = jobs.PopFront();
+    static_cast<Job&>(job).Drop();
+  }
+}
+
+void GolangThreadPool::Wait() noexcept {
+  for (auto& worker : _workers) {
+    worker.join();
+  }
+  _workers.clear();
+}
+
+void GolangThreadPool::Loop(Worker& worker) noexcept {
+  tls_worker = &worker;
+  bool spinning = false;
+  while (true) {
+    auto* job = FindJob(worker, spinning);
+    if (job == nullptr) {
+      if (Park(spinning)) {
+        continue;
+      }
+      break;
+    }
+    if (spinning) {
+      spinning = false;
+      // We were the last spinning worker, so maybe there are more jobs, let another worker look for it
+      if (_spinning.fetch_sub(1, std::memory_order_seq_cst) == 1) {
+        WakeUp();
+      }
+    }
+    job->Call();
+  }
+  tls_worker = nullptr;
+}
+
+Job* GolangThreadPool::FindJob(Worker& worker, bool& spinning) noexcept {
+  if ((_state.load(std::memory_order_acquire) & kHardStop) != 0) {
+    if (auto* job = worker._next.exchange(nullptr, std::memory_order_acq_rel); job != nullptr) {
+      job->Drop();
+    }
+    while (auto* job = worker.Pop()) {
+      job->Drop();
+    }
+    return nullptr;
+  }
+  if (++worker._tick % kGlobalPeriod == 0 && _global_count.load(std::memory_order_relaxed) != 0) {
+    if (auto* job = PopGlobal(worker)) {
+      return job;
+    }
+  }
+  if (worker._next_in_row < kNextLimit) {
+    if (auto* job = worker._next.exchange(nullptr, std::memory_order_acq_rel); job != nullptr) {
+      ++worker._next_in_row;
+      return job;
+    }
+  }
+  worker._next_in_row = 0;
+  if (auto* job = worker.Pop()) {
+    return job;
+  }
+  if (auto* job = worker._next.exchange(nullptr, std::memory_order_acq_rel); job != nullptr) {
+    return job;
+  }
+  if (_global_count.load(std::memory_order_relaxed) != 0) {
+    if (auto* job = PopGlobal(worker)) {
+      return job;
+    }
+  }
+  if (!spinning) {
+    // Don't burn cpu, if a half of the busy workers already looking for jobs
+    const auto busy = _count - _sleeping.load(std::memory_order_relaxed);
+    if (2 * _spinning.load(std::memory_order_relaxed) >= busy) {
+      return nullptr;
+    }
+    spinning = true;
+    _spinning.fetch_add(1, std::memory_order_seq_cst);
+  }
+  return Steal(worker);
+}
+
+Job* GolangThreadPool::PopGlobal(Worker& worker) noexcept {
+  std::lock_guard lock{_m};
+  const auto size = _global_count.load(std::memory_order_relaxed);
+  if (size == 0) {
+    return nullptr;
+  }
+  auto n = std::min<std::size_t>(size / _count + 1, Worker::kSize / 2);
+  auto* job = &static_cast<Job&>(_global.PopFront());
+  std::size_t taken = 1;
+  for (; taken != n; ++taken) {
+    if (_global.Empty()) {
+      break;
+    }
+    auto& next = static_cast<Job&>(_global.PopFront());
+    if (!worker.Push(next)) {
+      _global.PushFront(next);
+      break;
+    }
+  }
+  _global_count.store(size - taken, std::memory_order_relaxed);
+  return job;
+}
+
+Job* GolangThreadPool::Steal(Worker& worker) noexcept {
+  for (std::uint32_t round = 0; round != kStealRounds; ++round) {
+    const auto offset = worker.Random() % _count;
+    for (std::uint32_t i = 0; i != _count; ++i) {
+      auto& victim = _local[(offset + i) % _count];
+      if (&victim == &worker) {
+        continue;
+      }
+      if (auto* job = worker.Grab(victim)) {
+        return job;
+      }
+    }
+  }
+  return nullptr;
+}
+
+bool GolangThreadPool::Park(bool& spinning) noexcept {
+  if (spinning) {
+    spinning = false;
+    _spinning.fetch_sub(1, std::memory_order_seq_cst);
+  }
+  std::unique_lock lock{_m};
+  _sleeping.fetch_add(1, std::memory_order_seq_cst);
+  while (true) {
+    const auto state = _state.load(std::memory_order_relaxed);
+    // Submit publish job and then check _sleeping, we increment _sleeping and then check jobs
+    if ((state & kHardStop) == 0 && HasJobs()) {
+      break;
+    }
+    if ((state & kStopped) != 0) {
+      _sleeping.fetch_sub(1, std::memory_order_relaxed);
+      return false;
+    }
+    if ((state & kWantStop) != 0 && _sleeping.load(std::memory_order_relaxed) == _count) {
+      _sleeping.fetch_sub(1, std::memory_order_relaxed);
+      Stop(std::move(lock), kStopped);
+      return false;
+    }
+    _idle.wait(lock);
+    if (_wakeups != 0) {
+      --_wakeups;
+      spinning = true;  // WakeUp already incremented _spinning for us
+      break;
+    }
+  }
+  _sleeping.fetch_sub(1, std::memory_order_relaxed);
+  return true;
+}
+
+void GolangThreadPool::PushGlobal(detail::List& jobs, std::uint32_t count) noexcept {
+  std::unique_lock lock{_m};
+  if ((_state.load(std::memory_order_relaxed) & kHardStop) != 0) {
+    lock.unlock();
+    while (!jobs.Empty()) {
+      auto& job = jobs.PopFront();
+      static_cast<Job&>(job).Drop();
+    }
+    return;
+  }
+  _global.PushBack(std::move(jobs));
+  _global_count.store(_global_count.load(std::memory_order_relaxed) + count, std::memory_order_seq_cst);
+}
+
+void GolangThreadPool::WakeUp() noexcept {
+  // Only one worker should spin at once, it will wake up another worker when it finds a job
+  std::uint32_t expected = 0;
+  if (_sleeping.load(std::memory_order_seq_cst) == 0 || _spinning.load(std::memory_order_seq_cst) != 0 ||
+      !_spinning.compare_exchange_strong(expected, 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+    return;
+  }
+  std::unique_lock lock{_m};
+  if (_sleeping.load(std::memory_order_relaxed) <= _wakeups) {
+    lock.unlock();
+    _spinning.fetch_sub(1, std::memory_order_seq_cst);
+    return;
+  }
+  ++_wakeups;
+  lock.unlock();
+  _idle.notify_one();
+}
+
+bool GolangThreadPool::HasJobs() const noexcept {
+  if (_global_count.load(std::memory_order_seq_cst) != 0) {
+    return true;
+  }
+  for (std::uint32_t i = 0; i != _count; ++i) {
+    if (!_local[i].Empty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void GolangThreadPool::Stop(std::unique_lock<yaclib_std::mutex>&& lock, std::uint32_t state) noexcept {
+  _state.fetch_or(state, std::memory_order_release);
+  lock.unlock();
+  _idle.notify_all();
+}
+
+IntrusivePtr<GolangThreadPool> MakeGolangThreadPool(std::uint64_t threads) {
+  return MakeShared<GolangThreadPool>(1, threads);
+}
+
+}  // namespace yaclib
@@ -0,0 +1,71 @@
+#include <yaclib/runtime/detail/idle_workers.hpp>
+
+namespace yaclib::detail {
+
+IdleWorkers::IdleWorkers(std::uint32_t count, std::uint32_t spin_budget) noexcept
+    : _count{count},
+      // Spinning on the single core only steals time from the thread that can submit job
+      _spin_budget{yaclib_std::thread::hardware_concurrency() > 1 ? spin_budget : 0} {
+}
+
+bool IdleWorkers::StartSpinning() noexcept {
+  if (_spin_budget == 0) {
+    return false;
+  }
+  auto spinning = _spinning.load(std::memory_order_relaxed);
+  do {
+    if (2 * spinning >= _count) {
+      return false;
+    }
+  } while (!_spinning.compare_exchange_weak(spinning, spinning + 1, std::memory_order_seq_cst,
+                                            std::memory_order_relaxed));
+  return true;
+}
+
+bool IdleWorkers::StopSpinning() noexcept {
+  return _spinning.fetch_sub(1, std::memory_order_seq_cst) == 1;
+}
+
+void IdleWorkers::CancelSpinning() noexcept {
+  _spinning.fetch_sub(1, std::memory_order_seq_cst);
+}
+
+void IdleWorkers::Park() noexcept {
+  _sleeping.fetch_add(1, std::memory_order_seq_cst);
+}
+
+bool IdleWorkers::Woken() noexcept {
+  if (_wakeups == 0) {
+    return false;
+  }
+  --_wakeups;
+  return true;
+}
+
+void IdleWorkers::Unpark() noexcept {
+  _sleeping.fetch_sub(1, std::memory_order_relaxed);
+}
+
+std::uint32_t IdleWorkers::Sleeping() const noexcept {
+  return _sleeping.load(std::memory_order_relaxed);
+}
+
+void IdleWorkers::WakeUp(yaclib_std::mutex& m, yaclib_std::condition_variable& idle) noexcept {
+  // Nobody sleeps, or the spinner will find the job, or the woken worker, which is accounted as spinner, will do it
+  std::uint32_t expected = 0;
+  if (_sleeping.load(std::memory_order_seq_cst) == 0 || _spinning.load(std::memory_order_seq_cst) != 0 ||
+      !_spinning.compare_exchange_strong(expected, 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+    return;
+  }
+  std::unique_lock lock{m};
+  if (_sleeping.load(std::memory_order_relaxed) <= _wakeups) {
+    lock.unlock();
+    _spinning.fetch_sub(1, std::memory_order_seq_cst);
+    return;
+  }
+  ++_wakeups;
+  lock.unlock();
+  idle.notify_one();
+}
+
+}  // namespace yaclib::detail
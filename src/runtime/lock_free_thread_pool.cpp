@@ -0,0 +1,266 @@
+#include <yaclib/log.hpp>
+#include <yaclib/runtime/lock_free_thread_pool.hpp>
+#include <yaclib/util/helper.hpp>
+
+#include <utility>
+
+namespace yaclib {
+namespace {
+
+constexpr std::uint32_t kStopped = 1U;
+constexpr std::uint32_t kWantStop = 2U;
+constexpr std::uint32_t kHardStop = 4U;
+// All workers exited, so Submit, which was concurrent with Stop, should drop its job by itself
+constexpr std::uint32_t kExited = 8U;
+
+std::size_t RoundUp(std::size_t capacity) noexcept {
+  std::size_t size = 2;
+  while (size < capacity) {
+    size *= 2;
+  }
+  return size;
+}
+
+}  // namespace
+
+LockFreeThreadPool::LockFreeThreadPool(std::uint64_t threads, std::size_t capacity, std::uint32_t spin_budget)
+    : _running{static_cast<std::uint32_t>(threads)},
+      _mask{RoundUp(capacity) - 1},
+      _cells{std::make_unique<Cell[]>(_mask + 1)},
+      _count{static_cast<std::uint32_t>(threads)},
+      _idle_workers{_count, spin_budget} {
+  for (std::size_t i = 0; i <= _mask; ++i) {
+    _cells[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  _workers.reserve(threads);
+  for (std::uint64_t i = 0; i != threads; ++i) {
+    _workers.emplace_back([&] {
+      Loop();
+    });
+  }
+}
+
+LockFreeThreadPool::~LockFreeThreadPool() noexcept {
+  YACLIB_DEBUG(!_workers.empty(), "You need explicitly join ThreadPool");
+}
+
+IExecutor::Type LockFreeThreadPool::Tag() const noexcept {
+  return Type::LockFreeThreadPool;
+}
+
+bool LockFreeThreadPool::Alive() const noexcept {
+  return (_state.load(std::memory_order_acquire) & kStopped) == 0;
+}
+
+void LockFreeThreadPool::Submit(Job& job) noexcept {
+  if ((_state.load(std::memory_order_acquire) & kStopped) != 0) {
+    return job.Drop();
+  }
+  if (_overflow_count.load(std::memory_order_relaxed) != 0 || !Push(job)) {
+    std::unique_lock lock{_m};
+    _overflow.PushBack(job);
+    _overflow_count.store(_overflow_count.load(std::memory_order_relaxed) + 1, std::memory_order_seq_cst);
+  }
+  // Push publish job and then check _state and idle workers, Park account sleeping worker and then check jobs
+  const auto state = _state.load(std::memory_order_seq_cst);
+  if ((state & kExited) != 0) {
+    return DropJobs();
+  }
+  WakeUp();
+}
+
+void LockFreeThreadPool::SoftStop() noexcept {
+  std::unique_lock lock{_m};
+  if (_idle_workers.Sleeping() == _count && Empty()) {
+    Stop(std::move(lock), kStopped);
+  } else {
+    _state.fetch_or(kWantStop, std::memory_order_relaxed);
+  }
+}
+
+void LockFreeThreadPool::Stop() noexcept {
+  Stop(std::unique_lock{_m}, kStopped);
+}
+
+void LockFreeThreadPool::HardStop() noexcept {
+  Stop(std::unique_lock{_m}, kStopped | kHardStop);
+  DropJobs();
+}
+
+void LockFreeThreadPool::Wait() noexcept {
+  for (auto& worker : _workers) {
+    worker.join();
+  }
+  _workers.clear();
+}
+
+void LockFreeThreadPool::Loop() noexcept {
+  bool spinning = false;
+  while ((_state.load(std::memory_order_relaxed) & kHardStop) == 0) {
+    if (auto* job = Pop(); job != nullptr) {
+      if (spinning) {
+        spinning = false;
+        StopSpinning();
+      }
+      job->Call();
+      continue;
+    }
+    if (!spinning) {
+      spinning = _idle_workers.StartSpinning();
+    }
+    if (spinning) {
+      if (_idle_workers.Spin([&] {
+            return !Empty();
+          })) {
+        continue;
+      }
+      // Submit skipped wakeup while we were spinning, so Park checks jobs after we stop spinning
+      spinning = false;
+      _idle_workers.CancelSpinning();
+    }
+    if (!Park(spinning)) {
+      break;
+    }
+  }
+  if (_running.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    _state.fetch_or(kExited, std::memory_order_seq_cst);
+    DropJobs();
+  }
+}
+
+bool LockFreeThreadPool::Park(bool& spinning) noexcept {
+  std::unique_lock lock{_m};
+  _idle_workers.Park();
+  bool result = true;
+  while (true) {
+    const auto state = _state.load(std::memory_order_relaxed);
+    if ((state & kHardStop) != 0) {
+      result = false;
+      break;
+    }
+    if (!Empty()) {
+      break;
+    }
+    if ((state & kStopped) != 0) {
+      result = false;
+      break;
+    }
+    if ((state & kWantStop) != 0 && _idle_workers.Sleeping() == _count) {
+      _idle_workers.Unpark();
+      Stop(std::move(lock), kStopped);
+      return false;
+    }
+    _idle.wait(lock);
+    if (_idle_workers.Woken()) {
+      spinning = true;  // WakeUp already accounted us as spinner
+      break;
+    }
+  }
+  _idle_workers.Unpark();
+  return result;
+}
+
+void LockFreeThreadPool::StopSpinning() noexcept {
+  // The last spinner found a job, so if there are more jobs someone else should look for them
+  if (_idle_workers.StopSpinning() && !Empty()) {
+    WakeUp();
+  }
+}
+
+void LockFreeThreadPool::WakeUp() noexcept {
+  _idle_workers.WakeUp(_m, _idle);
+}
+
+bool LockFreeThreadPool::Push(Job& job) noexcept {
+  auto pos = _push_pos.load(std::memory_order_relaxed);
+  while (true) {
+    auto& cell = _cells[pos & _mask];
+    const auto sequence = cell.sequence.load(std::memory_order_acquire);
+    const auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+    if (diff == 0) {
+      if (_push_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        cell.job = &job;
+        cell.sequence.store(pos + 1, std::memory_order_seq_cst);
+        return true;
+      }
+    } else if (diff < 0) {
+      return false;  // full
+    } else {
+      pos = _push_pos.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+Job* LockFreeThreadPool::Pop() noexcept {
+  auto pos = _pop_pos.load(std::memory_order_relaxed);
+  while (true) {
+    auto& cell = _cells[pos & _mask];
+    const auto sequence = cell.sequence.load(std::memory_order_acquire);
+    const auto diff = static_cast<std::ptrdiff_t>(sequence - (pos + 1));
+    if (diff == 0) {
+      if (_pop_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        auto* job = cell.job;
+        cell.sequence.store(pos + _mask + 1, std::memory_order_release);
+        return job;
+      }
+    } else if (diff < 0) {
+      return _overflow_count.load(std::memory_order_relaxed) != 0 ? PopOverflow() : nullptr;
+    } else {
+      pos = _pop_pos.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+Job* LockFreeThreadPool::PopOverflow() noexcept {
+  std::lock_guard lock{_m};
+  auto count = _overflow_count.load(std::memory_order_relaxed);
+  if (count == 0) {
+    return nullptr;
+  }
+  auto* job = &static_cast<Job&>(_overflow.PopFront());
+  --count;
+  // Move the rest to the queue, order is the same, because Submit doesn't use queue until overflow is empty
+  while (count != 0) {
+    auto& next = static_cast<Job&>(_overflow.PopFront());
+    if (!Push(next)) {
+      _overflow.PushFront(next);
+      break;
+    }
+    --count;
+  }
+  _overflow_count.store(count, std::memory_order_seq_cst);
+  return job;
+}
+
+bool LockFreeThreadPool::Empty() const noexcept {
+  if (_overflow_count.load(std::memory_order_seq_cst) != 0) {
+    return false;
+  }
+  const auto pos = _pop_pos.load(std::memory_order_seq_cst);
+  return _cells[pos & _mask].sequence.load(std::memory_order_seq_cst) != pos + 1;
+}
+
+void LockFreeThreadPool::DropJobs() noexcept {
+  while (auto* job = Pop()) {
+    job->Drop();
+  }
+}
+
+void LockFreeThreadPool::Stop(std::unique_lock<yaclib_std::mutex>&& lock, std::uint32_t state) noexcept {
+  if (_count == 0) {
+    state |= kExited;
+  }
+  _state.fetch_or(state, std::memory_order_seq_cst);
+  lock.unlock();
+  _idle.notify_all();
+  if (_count == 0) {
+    DropJobs();
+  }
+}
+
+IntrusivePtr<LockFreeThreadPool> MakeLockFreeThreadPool(std::uint64_t threads, std::size_t capacity,
+                                                        std::uint32_t spin_budget) {
+  return MakeShared<LockFreeThreadPool>(1, threads, capacity, spin_budget);
+}
+
+}  // namespace yaclib
@@ -0,0 +1,159 @@
+#include <yaclib/log.hpp>
+#include <yaclib/runtime/single_thread.hpp>
+#include <yaclib/util/helper.hpp>
+
+namespace yaclib {
+namespace {
+
+detail::Node* Reverse(detail::Node* node) noexcept {
+  detail::Node* prev = nullptr;
+  while (node != nullptr) {
+    auto* next = node->next;
+    node->next = prev;
+    prev = node;
+    node = next;
+  }
+  return prev;
+}
+
+}  // namespace
+
+SingleThread::SingleThread()
+    : _thread{[this] {
+        Loop();
+      }} {
+}
+
+SingleThread::~SingleThread() noexcept {
+  YACLIB_DEBUG(_thread.joinable(), "You need explicitly join SingleThread");
+}
+
+IExecutor::Type SingleThread::Tag() const noexcept {
+  return Type::SingleThread;
+}
+
+bool SingleThread::Alive() const noexcept {
+  return _inbox.load(std::memory_order_acquire) != &_stop;
+}
+
+void SingleThread::Submit(Job& job) noexcept {
+  Push(job, job);
+}
+
+void SingleThread::SubmitBatch(detail::List& jobs, std::size_t /*count*/) noexcept {
+  if (jobs.Empty()) {
+    return;
+  }
+  // Inbox is a stack, so the batch is linked in the reversed order and pushed with one CAS
+  auto [top, bottom] = jobs.PopAllReversed();
+  Push(*top, *bottom);
+}
+
+void SingleThread::Push(detail::Node& top, detail::Node& bottom) noexcept {
+  auto* head = _inbox.load(std::memory_order_relaxed);
+  do {
+    if (head == &_stop) {
+      bottom.next = nullptr;
+      for (auto* node = &top; node != nullptr;) {
+        auto* next = node->next;
+        static_cast<Job*>(node)->Drop();
+        node = next;
+      }
+      return;
+    }
+    bottom.next = head == &_sleep ? nullptr : head;
+  } while (!_inbox.compare_exchange_weak(head, &top, std::memory_order_acq_rel, std::memory_order_relaxed));
+  if (head == &_sleep) {
+    _event.Set();
+  }
+}
+
+void SingleThread::SoftStop() noexcept {
+  _want_stop.store(true, std::memory_order_seq_cst);
+  detail::Node* expected = &_sleep;
+  if (_inbox.compare_exchange_strong(expected, nullptr, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+    _event.Set();
+  }
+}
+
+void SingleThread::Stop() noexcept {
+  Stop(false);
+}
+
+void SingleThread::HardStop() noexcept {
+  Stop(true);
+}
+
+void SingleThread::Wait() noexcept {
+  if (_thread.joinable()) {
+    _thread.join();
+  }
+}
+
+void SingleThread::Loop() noexcept {
+  while (true) {
+    auto* head = _inbox.load(std::memory_order_acquire);
+    if (head == nullptr || head == &_sleep) {
+      Park();
+      continue;
+    }
+    if (head == &_stop) {
+      auto* node = Reverse(_stop.next);
+      while (node != nullptr) {
+        auto& job = static_cast<Job&>(*node);
+        node = node->next;
+        if (_hard_stop) {
+          job.Drop();
+        } else {
+          job.Call();
+        }
+      }
+      return;
+    }
+    if (!_inbox.compare_exchange_weak(head, nullptr, std::memory_order_acquire, std::memory_order_relaxed)) {
+      continue;
+    }
+    auto* node = Reverse(head);
+    do {
+      auto& job = static_cast<Job&>(*node);
+      node = node->next;
+      job.Call();
+    } while (node != nullptr);
+  }
+}
+
+void SingleThread::Park() noexcept {
+  _event.Reset();
+  detail::Node* expected = nullptr;
+  if (!_inbox.compare_exchange_strong(expected, &_sleep, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+    if (expected != &_sleep) {
+      return;
+    }
+  }
+  if (_want_stop.load(std::memory_order_seq_cst)) {
+    // SoftStop could see inbox before we set it to sleep, so we need to check it again
+    return Stop(false);
+  }
+  auto token = _event.Make();
+  _event.Wait(token);
+}
+
+void SingleThread::Stop(bool hard) noexcept {
+  if (_stopping.exchange(true, std::memory_order_relaxed)) {
+    return;
+  }
+  _hard_stop = hard;
+  auto* head = _inbox.load(std::memory_order_relaxed);
+  do {
+    _stop.next = head == &_sleep ? nullptr : head;
+  } while (!_inbox.compare_exchange_weak(head, &_stop, std::memory_order_acq_rel, std::memory_order_relaxed));
+  if (head == &_sleep) {
+    _event.Set();
+  }
+}
+
+IntrusivePtr<SingleThread> MakeSingleThread() {
+  return MakeShared<SingleThread>(1);
+}
+
+}  // namespace yaclib
@@ -0,0 +1,251 @@
+#include <yaclib/algo/detail/unique_core.hpp>
+#include <yaclib/log.hpp>
+#include <yaclib/runtime/timer_service.hpp>
+#include <yaclib/util/detail/intrusive_list.hpp>
+#include <yaclib/util/helper.hpp>
+
+#include <algorithm>
+#include <utility>
+
+namespace yaclib {
+namespace {
+
+std::uint32_t CountrZero(std::uint64_t x) noexcept {
+  YACLIB_ASSERT(x != 0);
+  // De Bruijn multiplication, because we don't rely on compiler builtins
+  static constexpr std::uint8_t kTable[64] = {
+    0,  1,  48, 2,  57, 49, 28, 3,  61, 58, 50, 42, 38, 29, 17, 4,  62, 55, 59, 36, 53, 51,
+    43, 22, 45, 39, 33, 30, 24, 18, 12, 5,  63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21,
+    44, 32, 23, 11, 46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19, 9,  13, 8,  7,  6,
+  };
+  return kTable[((x & (~x + 1)) * std::uint64_t{0x03f79d71b4cb0a89}) >> 58U];
+}
+
+class TimerCore : public detail::UniqueCore<void, StopError>, public TimerNode {
+ public:
+  void Call() noexcept final {
+    Store(std::in_place);
+    detail::Loop(this, SetResult<false>());
+  }
+
+  void Drop() noexcept final {
+    Store(StopTag{});
+    detail::Loop(this, SetResult<false>());
+  }
+};
+
+}  // namespace
+
+TimerService::TimerService(Clock::duration tick)
+    : _start{Clock::now()},
+      _tick{tick},
+      // Tick longer than an hour still should wait at least one tick
+      _max_wait{std::max(std::uint64_t{1}, static_cast<std::uint64_t>(std::chrono::hours{1} / tick))},
+      _thread{[this] {
+        Loop();
+      }} {
+}
+
+TimerService::~TimerService() noexcept {
+  YACLIB_DEBUG(_thread.joinable(), "You need explicitly join TimerService");
+}
+
+void TimerService::Arm(TimerNode& node, Job& job, IExecutor& e, Clock::time_point deadline) noexcept {
+  YACLIB_ASSERT(node._slot == TimerNode::kUnarmed);
+  node._job = &job;
+  node._executor = &e;
+  const auto ticks = Ticks(deadline, true);
+  std::unique_lock lock{_m};
+  if (_stop) {
+    lock.unlock();
+    return job.Drop();
+  }
+  if (ticks <= _now) {
+    lock.unlock();
+    return e.Submit(job);
+  }
+  node._deadline = ticks;
+  Link(node);
+  if (ticks < _wake_at) {
+    _wake_at = ticks;
+    lock.unlock();
+    _cv.notify_one();
+  }
+}
+
+bool TimerService::Cancel(TimerNode& node) noexcept {
+  std::lock_guard lock{_m};
+  if (node._slot == TimerNode::kUnarmed) {
+    return false;
+  }
+  Unlink(node);
+  return true;
+}
+
+FutureOn<> TimerService::ScheduleAt(IExecutor& e, Clock::time_point deadline) {
+  auto* core = MakeUnique<TimerCore>().Release();
+  e.IncRef();
+  core->detail::BaseCore::_executor.Reset(NoRefTag{}, &e);
+  FutureOn<> future{detail::UniqueCorePtr<void, StopError>{NoRefTag{}, core}};
+  Arm(*core, *core, e, deadline);
+  return future;
+}
+
+void TimerService::Stop() noexcept {
+  std::unique_lock lock{_m};
+  _stop = true;
+  detail::List jobs;
+  for (auto& head : _slots) {
+    for (auto* node = std::exchange(head, nullptr); node != nullptr; node = node->_next) {
+      node->_slot = TimerNode::kUnarmed;
+      jobs.PushBack(*node->_job);
+    }
+  }
+  _occupied.fill(0);
+  lock.unlock();
+  _cv.notify_one();
+  while (!jobs.Empty()) {
+    auto& job = jobs.PopFront();
+    static_cast<Job&>(job).Drop();
+  }
+}
+
+void TimerService::Wait() noexcept {
+  if (_thread.joinable()) {
+    _thread.join();
+  }
+}
+
+void TimerService::Loop() noexcept {
+  std::unique_lock lock{_m};
+  while (!_stop) {
+    const auto current = Ticks(Clock::now(), false);
+    std::uint64_t at = 0;
+    std::uint32_t slot = 0;
+    while (Next(at, slot) && at <= current) {
+      Process(at, slot);
+    }
+    _now = std::max(_now, current);
+    if (!_expired.Empty()) {
+      detail::List expired{std::move(_expired)};
+      lock.unlock();
+      Dispatch(expired);
+      lock.lock();
+      continue;
+    }
+    if (Next(at, slot)) {
+      _wake_at = at;
+      _cv.wait_until(lock, _start + _tick * static_cast<Clock::rep>(std::min(at, current + _max_wait)));
+    } else {
+      _wake_at = std::numeric_limits<std::uint64_t>::max();
+      _cv.wait(lock);
+    }
+  }
+}
+
+void TimerService::Link(TimerNode& node) noexcept {
+  YACLIB_ASSERT(node._deadline > _now);
+  std::uint32_t level = 0;
+  for (auto diff = (node._deadline ^ _now) >> kBits; diff != 0; diff >>= kBits) {
+    ++level;
+  }
+  const auto index = static_cast<std::uint32_t>(node._deadline >> (level * kBits)) & (kSlots - 1);
+  auto*& head = _slots[level * kSlots + index];
+  node._prev = nullptr;
+  node._next = head;
+  if (head != nullptr) {
+    head->_prev = &node;
+  }
+  head = &node;
+  node._slot = level * kSlots + index;
+  _occupied[level] |= std::uint64_t{1} << index;
+}
+
+void TimerService::Unlink(TimerNode& node) noexcept {
+  const auto slot = std::exchange(node._slot, TimerNode::kUnarmed);
+  if (node._prev != nullptr) {
+    node._prev->_next = node._next;
+  } else {
+    _slots[slot] = node._next;
+  }
+  if (node._next != nullptr) {
+    node._next->_prev = node._prev;
+  }
+  if (_slots[slot] == nullptr) {
+    _occupied[slot / kSlots] &= ~(std::uint64_t{1} << (slot % kSlots));
+  }
+}
+
+bool TimerService::Next(std::uint64_t& at, std::uint32_t& slot) const noexcept {
+  // Node at level L agrees with _now in all bits above level L, so its index isn't less than the current index.
+  // Node in the current slot of the level above zero needs to be moved to the lower level right now.
+  bool found = false;
+  for (std::uint32_t level = 0; level != kLevels; ++level) {
+    const auto shift = level * kBits;
+    const auto current = static_cast<std::uint32_t>(_now >> shift) & (kSlots - 1);
+    const auto mask = _occupied[level] & (~std::uint64_t{0} << current);
+    if (mask == 0) {
+      continue;
+    }
+    const auto index = CountrZero(mask);
+    const auto bits = shift + kBits;
+    const auto start = bits >= 64 ? std::uint64_t{0} : _now & ~((std::uint64_t{1} << bits) - 1);
+    const auto time = std::max(start + (std::uint64_t{index} << shift), _now);
+    if (!found || time < at) {
+      found = true;
+      at = time;
+      slot = level * kSlots + index;
+    }
+  }
+  return found;
+}
+
+void TimerService::Process(std::uint64_t at, std::uint32_t slot) noexcept {
+  _now = std::max(_now, at);
+  auto* node = std::exchange(_slots[slot], nullptr);
+  _occupied[slot / kSlots] &= ~(std::uint64_t{1} << (slot % kSlots));
+  while (node != nullptr) {
+    auto* next = node->_next;
+    node->_slot = TimerNode::kUnarmed;
+    if (node->_deadline <= _now) {
+      _expired.PushBack(*node);
+    } else {
+      Link(*node);
+    }
+    node = next;
+  }
+}
+
+void TimerService::Dispatch(detail::List& expired) noexcept {
+  detail::List batch;
+  std::size_t count = 0;
+  IExecutor* executor = nullptr;
+  while (!expired.Empty()) {
+    // Node can be destroyed by its job, so we don't touch it after the job is submitted
+    auto& node = static_cast<TimerNode&>(expired.PopFront());
+    if (node._executor != executor && count != 0) {
+      executor->SubmitBatch(batch, std::exchange(count, 0));
+    }
+    executor = node._executor;
+    batch.PushBack(*node._job);
+    ++count;
+  }
+  if (count != 0) {
+    executor->SubmitBatch(batch, count);
+  }
+}
+
+std::uint64_t TimerService::Ticks(Clock::time_point time, bool ceil) const noexcept {
+  if (time <= _start) {
+    return 0;
+  }
+  const auto delta = static_cast<std::uint64_t>((time - _start).count());
+  const auto tick = static_cast<std::uint64_t>(_tick.count());
+  return delta / tick + static_cast<std::uint64_t>(ceil && delta % tick != 0);
+}
+
+IntrusivePtr<TimerService> MakeTimerService(TimerService::Clock::duration tick) {
+  return MakeShared<TimerService>(1, tick);
+}
+
+}  // namespace yaclib
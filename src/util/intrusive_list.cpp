@@ -28,6 +28,14 @@ void List::PushBack(Node& node) noexcept {
   _tail = &node;
 }
 
+void List::PushBack(List&& other) noexcept {
+  if (other.Empty()) {
+    return;
+  }
+  _tail->next = std::exchange(other._head.next, nullptr);
+  _tail = std::exchange(other._tail, &other._head);
+}
+
 bool List::Empty() const noexcept {
   YACLIB_DEBUG((_head.next == nullptr) != (_tail == &_head), "List::Empty invariant is failed");
   return _head.next == nullptr;  // valid only for linear
@@ -43,4 +51,16 @@ Node& List::PopFront() noexcept {
   return *node;
 }
 
+std::pair<Node*, Node*> List::PopAllReversed() noexcept {
+  YACLIB_ASSERT(!Empty());
+  auto* bottom = &PopFront();
+  auto* top = bottom;
+  while (!Empty()) {
+    auto& node = PopFront();
+    node.next = top;
+    top = &node;
+  }
+  return {top, bottom};
+}
+
 }  // namespace yaclib::detail
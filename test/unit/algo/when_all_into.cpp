@@ -0,0 +1,87 @@
+#include <yaclib/async/contract.hpp>
+#include <yaclib/async/make.hpp>
+#include <yaclib/async/run.hpp>
+#include <yaclib/async/when_all.hpp>
+#include <yaclib/runtime/fair_thread_pool.hpp>
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace test {
+namespace {
+
+TEST(WhenAllInto, Array) {
+  std::array<yaclib::Future<int>, 3> futures;
+  std::array<yaclib::Promise<int>, 3> promises;
+  for (int i = 0; i != 3; ++i) {
+    std::tie(futures[i], promises[i]) = yaclib::MakeContract<int>();
+  }
+  std::array<int, 3> out{};
+  auto all = yaclib::WhenAll(futures.begin(), out);
+  std::move(promises[2]).Set(2);
+  EXPECT_EQ(out[2], 2);
+  std::move(promises[0]).Set(0);
+  EXPECT_FALSE(all.Ready());
+  std::move(promises[1]).Set(1);
+  EXPECT_TRUE(all.Ready());
+  EXPECT_TRUE(std::move(all).Get());
+  EXPECT_EQ(out, (std::array<int, 3>{0, 1, 2}));
+}
+
+TEST(WhenAllInto, Pointer) {
+  std::vector<yaclib::Future<int>> futures;
+  futures.push_back(yaclib::MakeFuture(1));
+  futures.push_back(yaclib::MakeFuture<int>(yaclib::StopTag{}));
+  std::vector<yaclib::Result<int>> out(futures.size());
+  auto all = yaclib::WhenAll<yaclib::FailPolicy::None>(futures.begin(), futures.size(), out.data());
+  EXPECT_TRUE(std::move(all).Get());
+  EXPECT_EQ(std::move(out[0]).Ok(), 1);
+  EXPECT_EQ(out[1].State(), yaclib::ResultState::Error);
+}
+
+TEST(WhenAllInto, FirstFail) {
+  std::array<yaclib::Future<>, 3> futures;
+  std::array<yaclib::Promise<>, 3> promises;
+  for (int i = 0; i != 3; ++i) {
+    std::tie(futures[i], promises[i]) = yaclib::MakeContract();
+  }
+  std::array<yaclib::Unit, 3> out;
+  auto all = yaclib::WhenAll(futures.begin(), out);
+  std::move(promises[1]).Set(std::make_exception_ptr(std::runtime_error{""}));
+  EXPECT_TRUE(promises[0].StopRequested());
+  EXPECT_TRUE(promises[2].StopRequested());
+  std::move(promises[2]).Set(std::make_exception_ptr(std::logic_error{""}));
+  // Output is ready only when nobody writes to the storage
+  EXPECT_FALSE(all.Ready());
+  std::move(promises[0]).Set();
+  EXPECT_THROW(std::ignore = std::move(all).Get().Ok(), std::runtime_error);
+}
+
+TEST(WhenAllInto, Stress) {
+  yaclib::FairThreadPool tp{4};
+  constexpr std::size_t kFutures = 64;
+  for (std::size_t it = 0; it != 100; ++it) {
+    std::array<yaclib::FutureOn<std::size_t>, kFutures> futures;
+    for (std::size_t i = 0; i != kFutures; ++i) {
+      futures[i] = yaclib::Run(tp, [i] {
+        return i * i;
+      });
+    }
+    std::array<std::size_t, kFutures> out{};
+    EXPECT_TRUE(yaclib::WhenAll(futures.begin(), out).Get());
+    for (std::size_t i = 0; i != kFutures; ++i) {
+      EXPECT_EQ(out[i], i * i);
+    }
+  }
+  tp.Stop();
+  tp.Wait();
+}
+
+}  // namespace
+}  // namespace test
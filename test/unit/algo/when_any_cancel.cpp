@@ -0,0 +1,145 @@
+#include <yaclib/async/contract.hpp>
+#include <yaclib/async/make.hpp>
+#include <yaclib/async/run.hpp>
+#include <yaclib/async/when_any.hpp>
+#include <yaclib/exe/manual.hpp>
+#include <yaclib/exe/submit.hpp>
+#include <yaclib/lazy/schedule.hpp>
+#include <yaclib/runtime/fair_thread_pool.hpp>
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <yaclib_std/atomic>
+
+#include <gtest/gtest.h>
+
+namespace test {
+namespace {
+
+TEST(WhenAnyCancel, Ready) {
+  auto [f, p] = yaclib::MakeContract<int>();
+  auto any = yaclib::WhenAnyCancel(yaclib::MakeFuture(1), std::move(f));
+  EXPECT_TRUE(p.StopRequested());
+  EXPECT_EQ(std::move(any).Get().Ok(), 1);
+  std::move(p).Set(2);
+}
+
+TEST(WhenAnyCancel, Promise) {
+  auto [f1, p1] = yaclib::MakeContract<int>();
+  auto [f2, p2] = yaclib::MakeContract<int>();
+  auto any = yaclib::WhenAnyCancel(std::move(f1), std::move(f2));
+  EXPECT_FALSE(p1.StopRequested());
+  EXPECT_FALSE(p2.StopRequested());
+  std::move(p2).Set(2);
+  EXPECT_TRUE(p1.StopRequested());
+  std::move(p1).Set(1);
+  EXPECT_EQ(std::move(any).Get().Ok(), 2);
+}
+
+TEST(WhenAnyCancel, Fail) {
+  // With LastFail the error isn't the winner, so nobody is stopped
+  auto [f1, p1] = yaclib::MakeContract<int>();
+  auto [f2, p2] = yaclib::MakeContract<int>();
+  auto any = yaclib::WhenAnyCancel(std::move(f1), std::move(f2));
+  std::move(p1).Set(yaclib::StopTag{});
+  EXPECT_FALSE(p2.StopRequested());
+  std::move(p2).Set(2);
+  EXPECT_EQ(std::move(any).Get().Ok(), 2);
+}
+
+TEST(WhenAnyCancel, SkipQueued) {
+  yaclib::ManualExecutor e;
+  int called = 0;
+  std::vector<yaclib::FutureOn<int>> futures;
+  for (int i = 0; i != 3; ++i) {
+    futures.push_back(yaclib::Run(e, [&, i] {
+      ++called;
+      return i;
+    }));
+  }
+  auto any = yaclib::WhenAnyCancel(futures.begin(), futures.end());
+  EXPECT_EQ(e.Drain(), 3);
+  EXPECT_EQ(called, 1);
+  EXPECT_EQ(std::move(any).Get().Ok(), 0);
+}
+
+TEST(WhenAnyCancel, Task) {
+  yaclib::ManualExecutor e;
+  int called = 0;
+  auto make = [&](int i) {
+    return yaclib::Schedule(e, [&, i] {
+      ++called;
+      return i;
+    });
+  };
+  auto any = yaclib::WhenAnyCancel(make(1), make(2), make(3));
+  EXPECT_EQ(e.Drain(), 3);
+  EXPECT_EQ(called, 1);
+  EXPECT_EQ(std::move(any).Get().Ok(), 1);
+
+  called = 0;
+  std::vector<yaclib::Task<int>> tasks;
+  for (int i = 0; i != 3; ++i) {
+    tasks.push_back(make(i));
+  }
+  auto all = yaclib::WhenAnyCancel(tasks.begin(), tasks.end());
+  EXPECT_EQ(e.Drain(), 3);
+  EXPECT_EQ(called, 1);
+  EXPECT_EQ(std::move(all).Get().Ok(), 0);
+}
+
+TEST(WhenAnyCancel, WorkSaved) {
+  constexpr std::size_t kJobs = 1000;
+  auto run = [&](bool cancel) {
+    yaclib::FairThreadPool tp{1};
+    // Hold the only worker until every future is attached, otherwise it could run all jobs first
+    auto [gate_f, gate_p] = yaclib::MakeContract();
+    yaclib::Submit(tp, [f = std::move(gate_f)]() mutable {
+      std::ignore = std::move(f).Get();
+    });
+    yaclib_std::atomic_size_t executed{0};
+    std::vector<yaclib::FutureOn<std::size_t>> futures;
+    futures.reserve(kJobs);
+    for (std::size_t i = 0; i != kJobs; ++i) {
+      futures.push_back(yaclib::Run(tp, [&, i] {
+        executed.fetch_add(1, std::memory_order_relaxed);
+        return i;
+      }));
+    }
+    auto any = cancel ? yaclib::WhenAnyCancel(futures.begin(), futures.end())
+                      : yaclib::WhenAny(futures.begin(), futures.end());
+    std::move(gate_p).Set();
+    EXPECT_EQ(std::move(any).Get().Ok(), 0);
+    tp.Stop();
+    tp.Wait();
+    return executed.load();
+  };
+  const auto all = run(false);
+  const auto saved = run(true);
+  EXPECT_EQ(all, kJobs);
+  EXPECT_EQ(saved, 1);
+}
+
+TEST(WhenAnyCancel, Stress) {
+  yaclib::FairThreadPool tp{4};
+  constexpr std::size_t kIterations = 200;
+  constexpr std::size_t kJobs = 50;
+  for (std::size_t it = 0; it != kIterations; ++it) {
+    std::vector<yaclib::FutureOn<std::size_t>> futures;
+    futures.reserve(kJobs);
+    for (std::size_t i = 0; i != kJobs; ++i) {
+      futures.push_back(yaclib::Run(tp, [i] {
+        return i;
+      }));
+    }
+    auto any = yaclib::WhenAnyCancel(futures.begin(), futures.end());
+    EXPECT_LT(std::move(any).Get().Ok(), kJobs);
+  }
+  tp.Stop();
+  tp.Wait();
+}
+
+}  // namespace
+}  // namespace test
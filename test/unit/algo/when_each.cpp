@@ -0,0 +1,78 @@
+#include <yaclib/async/contract.hpp>
+#include <yaclib/async/make.hpp>
+#include <yaclib/async/run.hpp>
+#include <yaclib/async/when_each.hpp>
+#include <yaclib/runtime/fair_thread_pool.hpp>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include <yaclib_std/atomic>
+
+#include <gtest/gtest.h>
+
+namespace test {
+namespace {
+
+TEST(WhenEach, Order) {
+  std::vector<yaclib::Future<int>> futures;
+  std::vector<yaclib::Promise<int>> promises;
+  for (int i = 0; i != 3; ++i) {
+    auto [f, p] = yaclib::MakeContract<int>();
+    futures.push_back(std::move(f));
+    promises.push_back(std::move(p));
+  }
+  std::vector<std::size_t> indices;
+  auto each = yaclib::WhenEach(futures.begin(), futures.end(), [&](std::size_t i, yaclib::Result<int> result) {
+    indices.push_back(i);
+    if (i == 0) {
+      EXPECT_EQ(result.State(), yaclib::ResultState::Error);
+    } else {
+      EXPECT_EQ(std::move(result).Ok(), static_cast<int>(i));
+    }
+  });
+  std::move(promises[2]).Set(2);
+  EXPECT_EQ(indices, (std::vector<std::size_t>{2}));
+  std::move(promises[0]).Set(yaclib::StopTag{});
+  EXPECT_EQ(indices, (std::vector<std::size_t>{2, 0}));
+  EXPECT_FALSE(each.Ready());
+  std::move(promises[1]).Set(1);
+  EXPECT_EQ(indices, (std::vector<std::size_t>{2, 0, 1}));
+  EXPECT_TRUE(each.Ready());
+}
+
+TEST(WhenEach, Ready) {
+  std::vector<yaclib::Future<>> futures;
+  futures.push_back(yaclib::MakeFuture());
+  futures.push_back(yaclib::MakeFuture());
+  std::size_t called = 0;
+  auto each = yaclib::WhenEach(futures.begin(), futures.size(), [&](std::size_t, yaclib::Result<> result) {
+    EXPECT_TRUE(result);
+    ++called;
+  });
+  EXPECT_TRUE(each.Ready());
+  EXPECT_EQ(called, 2);
+}
+
+TEST(WhenEach, Stress) {
+  yaclib::FairThreadPool tp{4};
+  constexpr std::size_t kFutures = 1000;
+  std::vector<yaclib::FutureOn<std::size_t>> futures;
+  for (std::size_t i = 0; i != kFutures; ++i) {
+    futures.push_back(yaclib::Run(tp, [i] {
+      return i;
+    }));
+  }
+  yaclib_std::atomic_size_t sum{0};
+  auto each = yaclib::WhenEach(futures.begin(), futures.end(), [&](std::size_t i, yaclib::Result<std::size_t> result) {
+    EXPECT_EQ(std::move(result).Ok(), i);
+    sum.fetch_add(i, std::memory_order_relaxed);
+  });
+  std::ignore = std::move(each).Get();
+  EXPECT_EQ(sum.load(), kFutures * (kFutures - 1) / 2);
+  tp.Stop();
+  tp.Wait();
+}
+
+}  // namespace
+}  // namespace test
@@ -0,0 +1,97 @@
+#include <yaclib/async/contract.hpp>
+#include <yaclib/async/make.hpp>
+#include <yaclib/async/run.hpp>
+#include <yaclib/async/when_reduce.hpp>
+#include <yaclib/runtime/fair_thread_pool.hpp>
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace test {
+namespace {
+
+TEST(WhenReduce, Sum) {
+  std::vector<yaclib::Future<int>> futures;
+  std::vector<yaclib::Promise<int>> promises;
+  for (int i = 0; i != 3; ++i) {
+    auto [f, p] = yaclib::MakeContract<int>();
+    futures.push_back(std::move(f));
+    promises.push_back(std::move(p));
+  }
+  auto sum = yaclib::WhenReduce(futures.begin(), futures.end(), 0, [](int a, int b) noexcept {
+    return a + b;
+  });
+  std::move(promises[1]).Set(1);
+  std::move(promises[2]).Set(2);
+  EXPECT_FALSE(sum.Ready());
+  std::move(promises[0]).Set(3);
+  EXPECT_EQ(std::move(sum).Get().Ok(), 6);
+}
+
+TEST(WhenReduce, Empty) {
+  std::vector<yaclib::Future<int>> futures;
+  auto sum = yaclib::WhenReduce(futures.begin(), futures.size(), 1, [](int a, int b) noexcept {
+    return a + b;
+  });
+  EXPECT_EQ(std::move(sum).Get().Ok(), 1);
+}
+
+TEST(WhenReduce, OtherType) {
+  std::vector<yaclib::Future<std::string>> futures;
+  futures.push_back(yaclib::MakeFuture<std::string>("ab"));
+  futures.push_back(yaclib::MakeFuture<std::string>("cde"));
+  auto length = yaclib::WhenReduce(futures.begin(), futures.size(), std::size_t{0}, [](std::size_t a, auto&& b) noexcept {
+    if constexpr (std::is_same_v<std::decay_t<decltype(b)>, std::string>) {
+      return a + b.size();
+    } else {
+      return a + b;
+    }
+  });
+  EXPECT_EQ(std::move(length).Get().Ok(), 5);
+}
+
+TEST(WhenReduce, FirstFail) {
+  std::vector<yaclib::Future<int>> futures;
+  std::vector<yaclib::Promise<int>> promises;
+  for (int i = 0; i != 3; ++i) {
+    auto [f, p] = yaclib::MakeContract<int>();
+    futures.push_back(std::move(f));
+    promises.push_back(std::move(p));
+  }
+  auto sum = yaclib::WhenReduce(futures.begin(), futures.end(), 0, [](int a, int b) noexcept {
+    return a + b;
+  });
+  std::move(promises[0]).Set(1);
+  std::move(promises[1]).Set(std::make_exception_ptr(std::runtime_error{""}));
+  EXPECT_TRUE(sum.Ready());
+  EXPECT_TRUE(promises[2].StopRequested());
+  std::move(promises[2]).Set(2);
+  EXPECT_THROW(std::ignore = std::move(sum).Get().Ok(), std::runtime_error);
+}
+
+TEST(WhenReduce, Stress) {
+  yaclib::FairThreadPool tp{4};
+  constexpr std::size_t kFutures = 10000;
+  std::vector<yaclib::FutureOn<std::size_t>> futures;
+  futures.reserve(kFutures);
+  for (std::size_t i = 0; i != kFutures; ++i) {
+    futures.push_back(yaclib::Run(tp, [i] {
+      return i;
+    }));
+  }
+  auto sum = yaclib::WhenReduce(futures.begin(), futures.end(), std::size_t{0}, [](std::size_t a, std::size_t b) noexcept {
+    return a + b;
+  });
+  EXPECT_EQ(std::move(sum).Get().Ok(), kFutures * (kFutures - 1) / 2);
+  tp.Stop();
+  tp.Wait();
+}
+
+}  // namespace
+}  // namespace test
@@ -0,0 +1,168 @@
+#include <yaclib/async/contract.hpp>
+#include <yaclib/async/make.hpp>
+#include <yaclib/async/run.hpp>
+#include <yaclib/async/when_some.hpp>
+#include <yaclib/exe/manual.hpp>
+#include <yaclib/runtime/fair_thread_pool.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace test {
+namespace {
+
+using Output = std::vector<std::pair<std::size_t, int>>;
+
+TEST(WhenSome, Quorum) {
+  std::vector<yaclib::Future<int>> futures;
+  std::vector<yaclib::Promise<int>> promises;
+  for (int i = 0; i != 3; ++i) {
+    auto [f, p] = yaclib::MakeContract<int>();
+    futures.push_back(std::move(f));
+    promises.push_back(std::move(p));
+  }
+  auto some = yaclib::WhenSome(2, futures.begin(), futures.end());
+  std::move(promises[2]).Set(20);
+  EXPECT_FALSE(some.Ready());
+  std::move(promises[0]).Set(0);
+  EXPECT_TRUE(some.Ready());
+  EXPECT_TRUE(promises[1].StopRequested());
+  std::move(promises[1]).Set(10);
+  EXPECT_EQ(std::move(some).Get().Ok(), (Output{{2, 20}, {0, 0}}));
+}
+
+TEST(WhenSome, SkipErrors) {
+  std::vector<yaclib::Future<int>> futures;
+  futures.push_back(yaclib::MakeFuture<int>(yaclib::StopTag{}));
+  futures.push_back(yaclib::MakeFuture(1));
+  futures.push_back(yaclib::MakeFuture<int>(std::make_exception_ptr(std::runtime_error{""})));
+  futures.push_back(yaclib::MakeFuture(3));
+  auto some = yaclib::WhenSome(2, futures.begin(), futures.size());
+  EXPECT_EQ(std::move(some).Get().Ok(), (Output{{1, 1}, {3, 3}}));
+}
+
+TEST(WhenSome, Unsatisfiable) {
+  std::vector<yaclib::Future<int>> futures;
+  std::vector<yaclib::Promise<int>> promises;
+  for (int i = 0; i != 3; ++i) {
+    auto [f, p] = yaclib::MakeContract<int>();
+    futures.push_back(std::move(f));
+    promises.push_back(std::move(p));
+  }
+  auto some = yaclib::WhenSome(2, futures.begin(), futures.end());
+  std::move(promises[0]).Set(yaclib::StopTag{});
+  EXPECT_FALSE(some.Ready());
+  // Only one value can arrive now, so there is no reason to wait for it
+  std::move(promises[1]).Set(std::make_exception_ptr(std::runtime_error{""}));
+  EXPECT_TRUE(some.Ready());
+  EXPECT_TRUE(promises[2].StopRequested());
+  std::move(promises[2]).Set(2);
+  EXPECT_THROW(std::ignore = std::move(some).Get().Ok(), std::runtime_error);
+}
+
+TEST(WhenSome, ValueThenUnsatisfiable) {
+  auto value = std::make_shared<int>(1);
+  {
+    std::vector<yaclib::Future<std::shared_ptr<int>>> futures;
+    std::vector<yaclib::Promise<std::shared_ptr<int>>> promises;
+    for (int i = 0; i != 3; ++i) {
+      auto [f, p] = yaclib::MakeContract<std::shared_ptr<int>>();
+      futures.push_back(std::move(f));
+      promises.push_back(std::move(p));
+    }
+    auto some = yaclib::WhenSome(2, futures.begin(), futures.end());
+    std::move(promises[0]).Set(value);
+    EXPECT_EQ(value.use_count(), 2);
+    std::move(promises[1]).Set(yaclib::StopTag{});
+    std::move(promises[2]).Set(std::make_exception_ptr(std::runtime_error{""}));
+    EXPECT_THROW(std::ignore = std::move(some).Get().Ok(), std::runtime_error);
+  }
+  // The stored winner is released with the combinator, even though the quorum failed
+  EXPECT_EQ(value.use_count(), 1);
+}
+
+TEST(WhenSome, Corner) {
+  std::vector<yaclib::Future<int>> futures;
+  futures.push_back(yaclib::MakeFuture(1));
+  futures.push_back(yaclib::MakeFuture(2));
+  auto none = yaclib::WhenSome(0, futures.begin(), futures.size());
+  EXPECT_TRUE(std::move(none).Get().Ok().empty());
+
+  futures.clear();
+  futures.push_back(yaclib::MakeFuture(1));
+  auto many = yaclib::WhenSome(2, futures.begin(), futures.size());
+  EXPECT_EQ(std::move(many).Get().Error(), yaclib::StopError{yaclib::StopTag{}});
+
+  futures.clear();
+  futures.push_back(yaclib::MakeFuture(1));
+  futures.push_back(yaclib::MakeFuture(2));
+  auto all = yaclib::WhenSome(2, futures.begin(), futures.size());
+  EXPECT_EQ(std::move(all).Get().Ok(), (Output{{0, 1}, {1, 2}}));
+}
+
+TEST(WhenSome, Empty) {
+  std::vector<yaclib::Future<int>> futures;
+  auto none = yaclib::WhenSome(0, futures.begin(), futures.end());
+  ASSERT_TRUE(none.Valid());
+  EXPECT_TRUE(none.Ready());
+  EXPECT_TRUE(std::move(none).Get().Ok().empty());
+
+  auto some = yaclib::WhenSome(1, futures.begin(), futures.size());
+  ASSERT_TRUE(some.Valid());
+  EXPECT_TRUE(some.Ready());
+  EXPECT_EQ(std::move(some).Get().Error(), yaclib::StopError{yaclib::StopTag{}});
+}
+
+TEST(WhenSome, Void) {
+  yaclib::ManualExecutor e;
+  int called = 0;
+  std::vector<yaclib::FutureOn<>> futures;
+  for (int i = 0; i != 4; ++i) {
+    futures.push_back(yaclib::Run(e, [&] {
+      ++called;
+    }));
+  }
+  auto some = yaclib::WhenSome(2, futures.begin(), futures.end());
+  EXPECT_EQ(e.Drain(), 4);
+  // Stragglers are released without running
+  EXPECT_EQ(called, 2);
+  auto output = std::move(some).Get().Ok();
+  ASSERT_EQ(output.size(), 2);
+  EXPECT_EQ(output[0].first, 0);
+  EXPECT_EQ(output[1].first, 1);
+}
+
+TEST(WhenSome, Stress) {
+  yaclib::FairThreadPool tp{4};
+  constexpr std::size_t kIterations = 200;
+  constexpr std::size_t kFutures = 10;
+  for (std::size_t it = 0; it != kIterations; ++it) {
+    std::vector<yaclib::FutureOn<std::size_t>> futures;
+    for (std::size_t i = 0; i != kFutures; ++i) {
+      futures.push_back(yaclib::Run(tp, [i]() -> yaclib::Result<std::size_t> {
+        if (i % 3 == 0) {
+          return yaclib::StopTag{};
+        }
+        return i;
+      }));
+    }
+    const auto k = it % 7;
+    auto output = yaclib::WhenSome(k, futures.begin(), futures.end()).Get().Ok();
+    ASSERT_EQ(output.size(), k);
+    for (auto [index, value] : output) {
+      EXPECT_EQ(index, value);
+      EXPECT_NE(index % 3, 0);
+    }
+  }
+  tp.Stop();
+  tp.Wait();
+}
+
+}  // namespace
+}  // namespace test
@@ -0,0 +1,118 @@
+#include <yaclib/async/contract.hpp>
+#include <yaclib/async/make.hpp>
+#include <yaclib/async/run.hpp>
+#include <yaclib/async/with_timeout.hpp>
+#include <yaclib/runtime/fair_thread_pool.hpp>
+#include <yaclib/runtime/timer_service.hpp>
+
+#include <chrono>
+#include <exception>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <yaclib_std/thread>
+
+#include <gtest/gtest.h>
+
+namespace test {
+namespace {
+
+using namespace std::chrono_literals;
+
+TEST(WithTimeout, Ready) {
+  yaclib::TimerService timer;
+  auto f = yaclib::WithTimeout(yaclib::MakeFuture(1), timer, 1h);
+  EXPECT_EQ(std::move(f).Get().Ok(), 1);
+  timer.Stop();
+  timer.Wait();
+}
+
+TEST(WithTimeout, Value) {
+  yaclib::TimerService timer;
+  auto [f, p] = yaclib::MakeContract<int>();
+  auto g = yaclib::WithTimeout(std::move(f), timer, 1h);
+  EXPECT_FALSE(g.Ready());
+  std::move(p).Set(42);
+  EXPECT_TRUE(g.Ready());
+  EXPECT_EQ(std::move(g).Get().Ok(), 42);
+  // Timer was disarmed, so Stop has nothing to drop
+  timer.Stop();
+  timer.Wait();
+}
+
+TEST(WithTimeout, Exception) {
+  yaclib::TimerService timer;
+  auto [f, p] = yaclib::MakeContract<void>();
+  auto g = yaclib::WithTimeout(std::move(f), timer, 1h);
+  std::move(p).Set(std::make_exception_ptr(std::runtime_error{""}));
+  EXPECT_THROW(std::ignore = std::move(g).Get().Ok(), std::runtime_error);
+  timer.Stop();
+  timer.Wait();
+}
+
+TEST(WithTimeout, Expired) {
+  yaclib::TimerService timer;
+  auto [f, p] = yaclib::MakeContract<int>();
+  const auto start = yaclib::TimerService::Clock::now();
+  auto g = yaclib::WithTimeout(std::move(f), timer, 10ms);
+  EXPECT_THROW(std::ignore = std::move(g).Get().Ok(), yaclib::TimeoutError);
+  EXPECT_GE(yaclib::TimerService::Clock::now() - start, 10ms);
+  // Promise is late, its result is ignored
+  std::move(p).Set(1);
+  timer.Stop();
+  timer.Wait();
+}
+
+TEST(WithTimeout, Stop) {
+  yaclib::TimerService timer;
+  auto [f, p] = yaclib::MakeContract<int>();
+  auto g = yaclib::WithTimeout(std::move(f), timer, 1h);
+  timer.Stop();
+  timer.Wait();
+  // Stop isn't a timeout
+  EXPECT_EQ(std::move(g).Get().Error(), yaclib::StopError{yaclib::StopTag{}});
+  std::move(p).Set(1);
+}
+
+TEST(WithTimeout, Dropped) {
+  yaclib::TimerService timer;
+  auto [f, p] = yaclib::MakeContract<int>();
+  std::ignore = yaclib::WithTimeout(std::move(f), timer, 1h);
+  std::move(p).Set(1);
+  timer.Stop();
+  timer.Wait();
+}
+
+TEST(WithTimeout, Race) {
+  yaclib::TimerService timer;
+  yaclib::FairThreadPool tp{4};
+  constexpr std::size_t kFutures = 10000;
+  std::vector<yaclib::Future<int>> futures;
+  futures.reserve(kFutures);
+  for (std::size_t i = 0; i != kFutures; ++i) {
+    auto f = yaclib::Run(tp, [i] {
+      yaclib_std::this_thread::sleep_for(std::chrono::microseconds{i % 3});
+      return static_cast<int>(i);
+    });
+    // Even futures can't lose, odd ones race with the timer
+    const auto timeout = i % 2 == 0 ? std::chrono::microseconds{1h} : std::chrono::microseconds{i % 2000};
+    futures.push_back(yaclib::WithTimeout(std::move(f), timer, timeout));
+  }
+  for (std::size_t i = 0; i != kFutures; ++i) {
+    auto result = std::move(futures[i]).Get();
+    if (result) {
+      EXPECT_EQ(std::move(result).Ok(), static_cast<int>(i));
+    } else {
+      EXPECT_EQ(i % 2, 1);
+      EXPECT_EQ(result.State(), yaclib::ResultState::Exception);
+    }
+  }
+  tp.Stop();
+  tp.Wait();
+  timer.Stop();
+  timer.Wait();
+}
+
+}  // namespace
+}  // namespace test
@@ -0,0 +1,100 @@
+#include <yaclib/async/bulk_run.hpp>
+#include <yaclib/exe/manual.hpp>
+#include <yaclib/runtime/fair_thread_pool.hpp>
+
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <yaclib_std/atomic>
+
+#include <gtest/gtest.h>
+
+namespace test {
+namespace {
+
+TEST(BulkRun, Values) {
+  yaclib::FairThreadPool tp{4};
+  constexpr std::size_t kJobs = 1000;
+  auto f = yaclib::BulkRun(tp, kJobs, [](std::size_t i) {
+    return i * 2;
+  });
+  auto values = std::move(f).Get().Ok();
+  ASSERT_EQ(values.size(), kJobs);
+  for (std::size_t i = 0; i != kJobs; ++i) {
+    EXPECT_EQ(values[i], i * 2);
+  }
+  tp.Stop();
+  tp.Wait();
+}
+
+TEST(BulkRun, Void) {
+  yaclib::FairThreadPool tp{4};
+  yaclib_std::atomic_size_t sum{0};
+  auto f = yaclib::BulkRun(tp, 100, [&](std::size_t i) {
+    sum.fetch_add(i, std::memory_order_relaxed);
+  });
+  EXPECT_TRUE(std::move(f).Get());
+  EXPECT_EQ(sum.load(), 4950);
+  tp.Stop();
+  tp.Wait();
+}
+
+TEST(BulkRun, Empty) {
+  yaclib::ManualExecutor e;
+  auto f = yaclib::BulkRun(e, 0, [](std::size_t i) {
+    return i;
+  });
+  EXPECT_TRUE(f.Ready());
+  EXPECT_TRUE(std::move(f).Get().Ok().empty());
+}
+
+TEST(BulkRun, Batch) {
+  yaclib::ManualExecutor e;
+  auto f = yaclib::BulkRun(e, 3, [](std::size_t i) {
+    return static_cast<int>(i);
+  });
+  EXPECT_FALSE(f.Ready());
+  EXPECT_EQ(e.Drain(), 3);
+  EXPECT_EQ(std::move(f).Get().Ok(), (std::vector<int>{0, 1, 2}));
+}
+
+TEST(BulkRun, Exception) {
+  yaclib::ManualExecutor e;
+  std::size_t called = 0;
+  auto f = yaclib::BulkRun(e, 3, [&](std::size_t i) {
+    ++called;
+    if (i == 0) {
+      throw std::runtime_error{""};
+    }
+  });
+  EXPECT_EQ(e.Drain(), 3);
+  // Calls after the first error are skipped
+  EXPECT_EQ(called, 1);
+  EXPECT_THROW(std::ignore = std::move(f).Get().Ok(), std::runtime_error);
+}
+
+TEST(BulkRun, Cancel) {
+  yaclib::ManualExecutor e;
+  std::size_t called = 0;
+  auto f = yaclib::BulkRun(e, 3, [&](std::size_t) {
+    ++called;
+  });
+  std::move(f).Cancel();
+  EXPECT_EQ(e.Drain(), 3);
+  EXPECT_EQ(called, 0);
+}
+
+TEST(BulkRun, Stop) {
+  yaclib::FairThreadPool tp{1};
+  tp.Stop();
+  auto f = yaclib::BulkRun(tp, 3, [](std::size_t i) {
+    return i;
+  });
+  EXPECT_EQ(std::move(f).Get().Error(), yaclib::StopError{yaclib::StopTag{}});
+  tp.Wait();
+}
+
+}  // namespace
+}  // namespace test
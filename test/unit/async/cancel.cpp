@@ -0,0 +1,242 @@
+#include <yaclib/async/contract.hpp>
+#include <yaclib/async/make.hpp>
+#include <yaclib/async/run.hpp>
+#include <yaclib/async/split.hpp>
+#include <yaclib/async/with_timeout.hpp>
+#include <yaclib/exe/manual.hpp>
+#include <yaclib/exe/submit.hpp>
+#include <yaclib/runtime/fair_thread_pool.hpp>
+#include <yaclib/runtime/timer_service.hpp>
+
+#include <chrono>
+#include <utility>
+#include <vector>
+#include <yaclib_std/atomic>
+#include <yaclib_std/thread>
+
+#include <gtest/gtest.h>
+
+namespace test {
+namespace {
+
+using namespace std::chrono_literals;
+
+struct StopJob final : yaclib::Job {
+  void Call() noexcept final {
+    called.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void Drop() noexcept final {
+    dropped.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  yaclib_std::atomic_int called{0};
+  yaclib_std::atomic_int dropped{0};
+};
+
+TEST(Cancel, NotRequested) {
+  auto [f, p] = yaclib::MakeContract<int>();
+  EXPECT_FALSE(p.StopRequested());
+  auto g = std::move(f).ThenInline([](int x) {
+    return x + 1;
+  });
+  EXPECT_FALSE(p.StopRequested());
+  std::move(p).Set(1);
+  EXPECT_EQ(std::move(g).Get().Ok(), 2);
+}
+
+TEST(Cancel, Promise) {
+  auto [f, p] = yaclib::MakeContract<int>();
+  std::move(f).Cancel();
+  EXPECT_TRUE(p.StopRequested());
+  std::move(p).Set(1);
+}
+
+TEST(Cancel, SkipThen) {
+  auto [f, p] = yaclib::MakeContract<int>();
+  int called = 0;
+  auto g = std::move(f)
+             .ThenInline([&](int x) {
+               ++called;
+               return x + 1;
+             })
+             .ThenInline([&](int x) {
+               ++called;
+               return x + 1;
+             });
+  EXPECT_FALSE(p.StopRequested());
+  std::move(g).Cancel();
+  EXPECT_TRUE(p.StopRequested());
+  std::move(p).Set(1);
+  EXPECT_EQ(called, 0);
+}
+
+TEST(Cancel, Deep) {
+  auto [f, p] = yaclib::MakeContract<int>();
+  int called = 0;
+  for (int i = 0; i != 100; ++i) {
+    f = std::move(f).ThenInline([&](int x) {
+      ++called;
+      return x + 1;
+    });
+  }
+  std::move(f).Cancel();
+  EXPECT_TRUE(p.StopRequested());
+  std::move(p).Set(1);
+  EXPECT_EQ(called, 0);
+}
+
+TEST(Cancel, Subscribe) {
+  auto [f, p] = yaclib::MakeContract<int>();
+  int called = 0;
+  p.Subscribe([&] {
+    ++called;
+  });
+  auto g = std::move(f).ThenInline([](int x) {
+    return x + 1;
+  });
+  EXPECT_EQ(called, 0);
+  std::move(g).Cancel();
+  EXPECT_EQ(called, 1);
+  std::move(p).Set(1);
+  EXPECT_EQ(called, 1);
+}
+
+TEST(Cancel, SubscribeAfterCancel) {
+  auto [f, p] = yaclib::MakeContract<int>();
+  std::move(f).Cancel();
+  int called = 0;
+  p.Subscribe([&] {
+    ++called;
+  });
+  EXPECT_EQ(called, 1);
+  std::move(p).Set(1);
+}
+
+TEST(Cancel, SubscribeDrop) {
+  auto [f, p] = yaclib::MakeContract<int>();
+  StopJob job;
+  p.Subscribe(job);
+  std::move(p).Set(1);
+  EXPECT_EQ(job.called.load(), 0);
+  EXPECT_EQ(job.dropped.load(), 1);
+  EXPECT_EQ(std::move(f).Get().Ok(), 1);
+}
+
+TEST(Cancel, Race) {
+  static constexpr int kIterations = 100;
+  yaclib::FairThreadPool tp{2};
+  std::vector<StopJob> jobs(kIterations);
+  for (auto& job : jobs) {
+    auto [f, p] = yaclib::MakeContract<int>();
+    p.Subscribe(job);
+    auto g = std::move(f).Then(tp, [](int x) {
+      return x + 1;
+    });
+    for (int i = 0; i != 10; ++i) {
+      g = std::move(g).Then([](int x) {
+        return x + 1;
+      });
+    }
+    yaclib::Submit(tp, [p = std::move(p)]() mutable {
+      std::move(p).Set(1);
+    });
+    std::move(g).Cancel();
+  }
+  tp.SoftStop();
+  tp.Wait();
+  for (auto& job : jobs) {
+    EXPECT_EQ(job.called.load() + job.dropped.load(), 1);
+  }
+}
+
+TEST(Cancel, SkipQueued) {
+  yaclib::ManualExecutor e;
+  int called = 0;
+  auto f = yaclib::Run(e, [&] {
+             ++called;
+           }).Then([&] {
+    ++called;
+  });
+  std::move(f).Cancel();
+  EXPECT_EQ(e.Drain(), 1);
+  EXPECT_EQ(called, 0);
+}
+
+TEST(Cancel, SkipRest) {
+  yaclib::ManualExecutor e1;
+  yaclib::ManualExecutor e2;
+  int called = 0;
+  auto [f, p] = yaclib::MakeContract<int>();
+  auto g = std::move(f)
+             .Then(e1,
+                   [&](int x) {
+                     ++called;
+                     return x;
+                   })
+             .Then(e2, [&](int x) {
+               ++called;
+               return x;
+             });
+  std::move(p).Set(1);
+  EXPECT_EQ(e1.Drain(), 1);
+  EXPECT_EQ(called, 1);
+  // Second callback is already in the queue, but not started yet
+  std::move(g).Cancel();
+  EXPECT_EQ(e2.Drain(), 1);
+  EXPECT_EQ(called, 1);
+}
+
+TEST(Cancel, Ready) {
+  auto f = yaclib::MakeFuture(1).ThenInline([](int x) {
+    return x;
+  });
+  std::move(f).Cancel();
+}
+
+TEST(Cancel, Shared) {
+  auto [f, p] = yaclib::MakeContract<int>();
+  auto shared = yaclib::Split(std::move(f));
+  auto g = shared.ThenInline([](int x) {
+    return x;
+  });
+  std::move(g).Cancel();
+  // Other SharedFutures can still need the result
+  EXPECT_FALSE(p.StopRequested());
+  std::move(p).Set(1);
+  EXPECT_EQ(shared.Get().Ok(), 1);
+}
+
+TEST(Cancel, Timeout) {
+  yaclib::TimerService timer;
+  auto [f, p] = yaclib::MakeContract<int>();
+  auto g = yaclib::WithTimeout(std::move(f), timer, 1ms);
+  EXPECT_EQ(std::move(g).Get().State(), yaclib::ResultState::Exception);
+  // Nobody needs the result after the timeout
+  EXPECT_TRUE(p.StopRequested());
+  std::move(p).Set(1);
+  timer.Stop();
+  timer.Wait();
+}
+
+TEST(Cancel, Poll) {
+  yaclib::FairThreadPool tp{1};
+  yaclib_std::atomic_bool started{false};
+  auto [f, p] = yaclib::MakeContract<int>();
+  yaclib::Submit(tp, [&, p = std::move(p)]() mutable {
+    started = true;
+    while (!p.StopRequested()) {
+      yaclib_std::this_thread::yield();
+    }
+    std::move(p).Set(yaclib::StopTag{});
+  });
+  while (!started) {
+    yaclib_std::this_thread::yield();
+  }
+  std::move(f).Cancel();
+  tp.Stop();
+  tp.Wait();
+}
+
+}  // namespace
+}  // namespace test
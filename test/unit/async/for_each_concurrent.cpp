@@ -0,0 +1,154 @@
+#include <yaclib/async/contract.hpp>
+#include <yaclib/async/for_each_concurrent.hpp>
+#include <yaclib/async/make.hpp>
+#include <yaclib/async/run.hpp>
+#include <yaclib/exe/manual.hpp>
+#include <yaclib/runtime/fair_thread_pool.hpp>
+
+#include <cstddef>
+#include <list>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <yaclib_std/atomic>
+
+#include <gtest/gtest.h>
+
+namespace test {
+namespace {
+
+TEST(ForEachConcurrent, Sync) {
+  yaclib::FairThreadPool tp{4};
+  std::vector<int> items(10'000, 1);
+  yaclib_std::atomic_int sum{0};
+  auto f = yaclib::ForEachConcurrent(tp, items.begin(), items.end(), 8, [&](int item) {
+    sum.fetch_add(item, std::memory_order_relaxed);
+  });
+  EXPECT_TRUE(std::move(f).Get());
+  EXPECT_EQ(sum.load(), 10'000);
+  tp.Stop();
+  tp.Wait();
+}
+
+TEST(ForEachConcurrent, InFlight) {
+  yaclib::FairThreadPool tp{4};
+  yaclib::FairThreadPool io{8};
+  constexpr std::size_t kLimit = 5;
+  std::vector<int> items(1000);
+  yaclib_std::atomic_size_t in_flight{0};
+  yaclib_std::atomic_size_t max_in_flight{0};
+  yaclib_std::atomic_size_t done{0};
+  auto f = yaclib::ForEachConcurrent(tp, items.begin(), items.end(), kLimit, [&](int&) {
+    auto now = in_flight.fetch_add(1) + 1;
+    auto max = max_in_flight.load();
+    while (now > max && !max_in_flight.compare_exchange_weak(max, now)) {
+    }
+    return yaclib::Run(io, [&] {
+      done.fetch_add(1);
+      in_flight.fetch_sub(1);
+    });
+  });
+  EXPECT_TRUE(std::move(f).Get());
+  EXPECT_EQ(done.load(), items.size());
+  EXPECT_LE(max_in_flight.load(), kLimit);
+  tp.Stop();
+  tp.Wait();
+  io.Stop();
+  io.Wait();
+}
+
+TEST(ForEachConcurrent, Slots) {
+  yaclib::ManualExecutor e;
+  std::vector<yaclib::Promise<>> promises;
+  std::list<int> items{1, 2, 3, 4, 5};
+  auto f = yaclib::ForEachConcurrent(e, items.begin(), items.end(), 2, [&](int) {
+    auto [future, promise] = yaclib::MakeContract();
+    promises.push_back(std::move(promise));
+    return std::move(future);
+  });
+  EXPECT_EQ(e.Drain(), 2);
+  EXPECT_EQ(promises.size(), 2);
+  std::move(promises[0]).Set();
+  // The slot is resumed on the executor and takes the next item
+  EXPECT_EQ(e.Drain(), 1);
+  EXPECT_EQ(promises.size(), 3);
+  for (std::size_t i = 1; i != promises.size(); ++i) {
+    std::move(promises[i]).Set();
+    std::ignore = e.Drain();
+  }
+  EXPECT_EQ(promises.size(), 5);
+  EXPECT_TRUE(f.Ready());
+  EXPECT_TRUE(std::move(f).Get());
+}
+
+TEST(ForEachConcurrent, Empty) {
+  yaclib::ManualExecutor e;
+  std::vector<int> items;
+  auto f = yaclib::ForEachConcurrent(e, items.begin(), items.end(), 64, [](int) {
+  });
+  EXPECT_EQ(e.Drain(), 1);
+  EXPECT_TRUE(std::move(f).Get());
+}
+
+TEST(ForEachConcurrent, FirstFail) {
+  yaclib::ManualExecutor e;
+  std::vector<int> items{0, 1, 2, 3};
+  std::size_t called = 0;
+  auto f = yaclib::ForEachConcurrent(e, items.begin(), items.end(), 1, [&](int item) {
+    ++called;
+    if (item == 1) {
+      return yaclib::MakeFuture<void>(std::make_exception_ptr(std::runtime_error{""}));
+    }
+    return yaclib::MakeFuture();
+  });
+  EXPECT_EQ(e.Drain(), 1);
+  EXPECT_EQ(called, 2);
+  EXPECT_THROW(std::ignore = std::move(f).Get().Ok(), std::runtime_error);
+}
+
+TEST(ForEachConcurrent, LastFail) {
+  yaclib::ManualExecutor e;
+  std::vector<int> items{0, 1, 2, 3};
+  std::size_t called = 0;
+  auto f = yaclib::ForEachConcurrent<yaclib::FailPolicy::LastFail>(e, items.begin(), items.end(), 1, [&](int item) {
+    ++called;
+    if (item == 1) {
+      throw std::logic_error{""};
+    }
+    if (item == 2) {
+      throw std::runtime_error{""};
+    }
+  });
+  EXPECT_EQ(e.Drain(), 1);
+  EXPECT_EQ(called, 4);
+  EXPECT_THROW(std::ignore = std::move(f).Get().Ok(), std::runtime_error);
+}
+
+TEST(ForEachConcurrent, None) {
+  yaclib::ManualExecutor e;
+  std::vector<int> items{0, 1, 2};
+  std::size_t called = 0;
+  auto f = yaclib::ForEachConcurrent<yaclib::FailPolicy::None>(e, items.begin(), items.end(), 3, [&](int) {
+    ++called;
+    throw std::runtime_error{""};
+  });
+  EXPECT_EQ(e.Drain(), 3);
+  EXPECT_EQ(called, 3);
+  EXPECT_TRUE(std::move(f).Get());
+}
+
+TEST(ForEachConcurrent, Cancel) {
+  yaclib::ManualExecutor e;
+  std::vector<int> items{0, 1, 2};
+  std::size_t called = 0;
+  auto f = yaclib::ForEachConcurrent(e, items.begin(), items.end(), 3, [&](int) {
+    ++called;
+  });
+  std::move(f).Cancel();
+  EXPECT_EQ(e.Drain(), 3);
+  EXPECT_EQ(called, 0);
+}
+
+}  // namespace
+}  // namespace test
@@ -0,0 +1,168 @@
+#include <yaclib/async/parallel_for.hpp>
+#include <yaclib/async/parallel_reduce.hpp>
+#include <yaclib/exe/manual.hpp>
+#include <yaclib/runtime/fair_thread_pool.hpp>
+
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <yaclib_std/atomic>
+
+#include <gtest/gtest.h>
+
+namespace test {
+namespace {
+
+TEST(ParallelFor, Simple) {
+  yaclib::FairThreadPool tp{4};
+  constexpr std::size_t kSize = 100'000;
+  std::vector<yaclib_std::atomic_int> visited(kSize);
+  auto f = yaclib::ParallelFor(tp, 0, kSize, 64, [&](std::size_t i) {
+    visited[i].fetch_add(1, std::memory_order_relaxed);
+  });
+  EXPECT_TRUE(std::move(f).Get());
+  for (auto& count : visited) {
+    EXPECT_EQ(count.load(), 1);
+  }
+  tp.Stop();
+  tp.Wait();
+}
+
+TEST(ParallelFor, Range) {
+  yaclib::ManualExecutor e;
+  std::vector<std::size_t> indices;
+  auto f = yaclib::ParallelFor(e, 10, 15, 0, [&](std::size_t i) {
+    indices.push_back(i);
+  });
+  EXPECT_EQ(e.Drain(), 4);
+  EXPECT_TRUE(std::move(f).Get());
+  EXPECT_EQ(indices, (std::vector<std::size_t>{10, 11, 12, 13, 14}));
+}
+
+TEST(ParallelFor, Empty) {
+  yaclib::ManualExecutor e;
+  auto f = yaclib::ParallelFor(e, 5, 5, 1, [](std::size_t) {
+  });
+  EXPECT_TRUE(f.Ready());
+  EXPECT_TRUE(std::move(f).Get());
+}
+
+TEST(ParallelFor, LazySplit) {
+  yaclib::ManualExecutor e;
+  std::size_t called = 0;
+  auto f = yaclib::ParallelFor(e, 0, 1024, 1, [&](std::size_t) {
+    ++called;
+  });
+  // Nobody steals the spawned halves, so every job splits only once
+  EXPECT_EQ(e.Drain(), 11);
+  EXPECT_EQ(called, 1024);
+  EXPECT_TRUE(std::move(f).Get());
+}
+
+TEST(ParallelFor, Exception) {
+  yaclib::ManualExecutor e;
+  std::size_t called = 0;
+  auto f = yaclib::ParallelFor(e, 0, 1000, 10, [&](std::size_t i) {
+    ++called;
+    if (i == 0) {
+      throw std::runtime_error{""};
+    }
+  });
+  EXPECT_EQ(e.Drain(), 2);
+  // The rest of the leaf and the leaves after the error are skipped
+  EXPECT_EQ(called, 1);
+  EXPECT_THROW(std::ignore = std::move(f).Get().Ok(), std::runtime_error);
+}
+
+TEST(ParallelFor, Cancel) {
+  yaclib::ManualExecutor e;
+  std::size_t called = 0;
+  auto f = yaclib::ParallelFor(e, 0, 1000, 10, [&](std::size_t) {
+    ++called;
+  });
+  std::move(f).Cancel();
+  EXPECT_EQ(e.Drain(), 1);
+  EXPECT_EQ(called, 0);
+}
+
+TEST(ParallelFor, Stop) {
+  yaclib::FairThreadPool tp{1};
+  tp.Stop();
+  auto f = yaclib::ParallelFor(tp, 0, 10, 1, [](std::size_t) {
+  });
+  EXPECT_EQ(std::move(f).Get().Error(), yaclib::StopError{yaclib::StopTag{}});
+  tp.Wait();
+}
+
+TEST(ParallelReduce, Sum) {
+  yaclib::FairThreadPool tp{4};
+  constexpr std::size_t kSize = 100'000;
+  auto f = yaclib::ParallelReduce(
+    tp, 0, kSize, 128, std::size_t{0},
+    [](std::size_t i) {
+      return i * 3;
+    },
+    [](std::size_t a, std::size_t b) {
+      return a + b;
+    });
+  EXPECT_EQ(std::move(f).Get().Ok(), 3 * kSize * (kSize - 1) / 2);
+  tp.Stop();
+  tp.Wait();
+}
+
+TEST(ParallelReduce, Order) {
+  yaclib::FairThreadPool tp{4};
+  constexpr std::size_t kSize = 10'000;
+  auto f = yaclib::ParallelReduce(
+    tp, 0, kSize, 16, std::vector<std::size_t>{},
+    [](std::size_t i) {
+      return std::vector<std::size_t>{i};
+    },
+    [](std::vector<std::size_t> a, std::vector<std::size_t> b) {
+      a.insert(a.end(), b.begin(), b.end());
+      return a;
+    });
+  const auto result = std::move(f).Get().Ok();
+  ASSERT_EQ(result.size(), kSize);
+  for (std::size_t i = 0; i != kSize; ++i) {
+    EXPECT_EQ(result[i], i);
+  }
+  tp.Stop();
+  tp.Wait();
+}
+
+TEST(ParallelReduce, Empty) {
+  yaclib::ManualExecutor e;
+  auto f = yaclib::ParallelReduce(
+    e, 0, 0, 1, 7,
+    [](std::size_t) {
+      return 1;
+    },
+    [](int a, int b) {
+      return a * b;
+    });
+  EXPECT_TRUE(f.Ready());
+  EXPECT_EQ(std::move(f).Get().Ok(), 7);
+}
+
+TEST(ParallelReduce, Exception) {
+  yaclib::ManualExecutor e;
+  auto f = yaclib::ParallelReduce(
+    e, 0, 100, 1, 0,
+    [](std::size_t i) -> int {
+      if (i == 50) {
+        throw std::runtime_error{""};
+      }
+      return 1;
+    },
+    [](int a, int b) {
+      return a + b;
+    });
+  EXPECT_EQ(e.Drain(), 3);
+  EXPECT_THROW(std::ignore = std::move(f).Get().Ok(), std::runtime_error);
+}
+
+}  // namespace
+}  // namespace test
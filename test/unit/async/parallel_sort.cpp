@@ -0,0 +1,151 @@
+#include <yaclib/async/parallel_merge.hpp>
+#include <yaclib/async/parallel_scan.hpp>
+#include <yaclib/async/parallel_sort.hpp>
+#include <yaclib/exe/manual.hpp>
+#include <yaclib/runtime/fair_thread_pool.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace test {
+namespace {
+
+std::vector<int> Random(std::size_t size, std::uint32_t seed) {
+  std::mt19937 gen{seed};
+  std::uniform_int_distribution<int> dist{-1000, 1000};
+  std::vector<int> data(size);
+  for (auto& value : data) {
+    value = dist(gen);
+  }
+  return data;
+}
+
+// Sizes around the chunk boundaries, so an odd and an even count of merge passes are both checked
+const std::size_t kSizes[] = {0, 1, 1000, 32768, 32769, 65536 + 5, 100'000, 300'007};
+
+TEST(ParallelSort, Simple) {
+  yaclib::FairThreadPool tp{4};
+  for (auto size : kSizes) {
+    auto data = Random(size, static_cast<std::uint32_t>(size));
+    auto expected = data;
+    std::sort(expected.begin(), expected.end());
+    EXPECT_TRUE(yaclib::ParallelSort(tp, data.begin(), data.end()).Get());
+    EXPECT_EQ(data, expected) << size;
+  }
+  tp.Stop();
+  tp.Wait();
+}
+
+TEST(ParallelSort, Compare) {
+  yaclib::FairThreadPool tp{2};
+  auto data = Random(100'000, 1);
+  auto expected = data;
+  std::sort(expected.begin(), expected.end(), std::greater{});
+  EXPECT_TRUE(yaclib::ParallelSort(tp, data.data(), data.data() + data.size(), std::greater{}).Get());
+  EXPECT_EQ(data, expected);
+  tp.Stop();
+  tp.Wait();
+}
+
+TEST(ParallelSort, Exception) {
+  yaclib::ManualExecutor e;
+  auto data = Random(100'000, 2);
+  auto f = yaclib::ParallelSort(e, data.begin(), data.end(), [](int a, int b) {
+    if (a == b) {
+      throw std::runtime_error{""};
+    }
+    return a < b;
+  });
+  while (e.Drain() != 0) {
+  }
+  EXPECT_THROW(std::ignore = std::move(f).Get().Ok(), std::runtime_error);
+}
+
+TEST(ParallelInclusiveScan, Simple) {
+  yaclib::FairThreadPool tp{4};
+  for (auto size : kSizes) {
+    auto data = Random(size, static_cast<std::uint32_t>(size));
+    std::vector<int> expected(size);
+    std::inclusive_scan(data.begin(), data.end(), expected.begin());
+    std::vector<int> output(size);
+    EXPECT_TRUE(yaclib::ParallelInclusiveScan(tp, data.begin(), data.end(), output.begin()).Get());
+    EXPECT_EQ(output, expected) << size;
+    // In place
+    EXPECT_TRUE(yaclib::ParallelInclusiveScan(tp, data.begin(), data.end(), data.begin()).Get());
+    EXPECT_EQ(data, expected) << size;
+  }
+  tp.Stop();
+  tp.Wait();
+}
+
+TEST(ParallelInclusiveScan, NotCommutative) {
+  yaclib::ManualExecutor e;
+  constexpr std::size_t kSize = 100'000;
+  using Affine = std::pair<std::uint64_t, std::uint64_t>;
+  std::vector<Affine> data(kSize);
+  for (std::size_t i = 0; i != kSize; ++i) {
+    data[i] = {i % 7 + 1, i % 5};
+  }
+  // Composition of x -> x * a + b maps is associative, but not commutative
+  const auto op = [](const Affine& l, const Affine& r) {
+    return Affine{l.first * r.first, l.second * r.first + r.second};
+  };
+  std::vector<Affine> expected(kSize);
+  std::inclusive_scan(data.begin(), data.end(), expected.begin(), op);
+  auto f = yaclib::ParallelInclusiveScan(e, data.begin(), data.end(), data.begin(), op);
+  while (e.Drain() != 0) {
+  }
+  EXPECT_TRUE(std::move(f).Get());
+  EXPECT_EQ(data, expected);
+}
+
+TEST(ParallelMerge, Simple) {
+  yaclib::FairThreadPool tp{4};
+  for (auto size : kSizes) {
+    auto a = Random(size, 1);
+    auto b = Random(size / 3, 2);
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+    std::vector<int> expected(a.size() + b.size());
+    std::merge(a.begin(), a.end(), b.begin(), b.end(), expected.begin());
+    std::vector<int> output(expected.size());
+    EXPECT_TRUE(yaclib::ParallelMerge(tp, a.begin(), a.end(), b.begin(), b.end(), output.begin()).Get());
+    EXPECT_EQ(output, expected) << size;
+  }
+  tp.Stop();
+  tp.Wait();
+}
+
+TEST(ParallelMerge, Stable) {
+  yaclib::FairThreadPool tp{4};
+  constexpr std::size_t kSize = 100'000;
+  std::vector<std::pair<int, int>> a(kSize);
+  std::vector<std::pair<int, int>> b(kSize);
+  for (std::size_t i = 0; i != kSize; ++i) {
+    a[i] = {static_cast<int>(i / 1000), 0};
+    b[i] = {static_cast<int>(i / 1000), 1};
+  }
+  const auto by_key = [](const auto& l, const auto& r) {
+    return l.first < r.first;
+  };
+  std::vector<std::pair<int, int>> expected(2 * kSize);
+  std::merge(a.begin(), a.end(), b.begin(), b.end(), expected.begin(), by_key);
+  std::vector<std::pair<int, int>> output(2 * kSize);
+  EXPECT_TRUE(yaclib::ParallelMerge(tp, a.begin(), a.end(), b.begin(), b.end(), output.begin(), by_key).Get());
+  EXPECT_EQ(output, expected);
+  tp.Stop();
+  tp.Wait();
+}
+
+}  // namespace
+}  // namespace test
@@ -0,0 +1,98 @@
+#include <yaclib/async/parallel_transform.hpp>
+#include <yaclib/exe/manual.hpp>
+#include <yaclib/runtime/fair_thread_pool.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <yaclib_std/atomic>
+
+#include <gtest/gtest.h>
+
+namespace test {
+namespace {
+
+TEST(ParallelTransform, Element) {
+  yaclib::FairThreadPool tp{4};
+  for (std::size_t offset = 0; offset != 4; ++offset) {
+    constexpr std::size_t kSize = 300'000;
+    std::vector<float> in(kSize + offset);
+    for (std::size_t i = 0; i != in.size(); ++i) {
+      in[i] = static_cast<float>(i);
+    }
+    std::vector<double> out(kSize + offset);
+    auto f = yaclib::ParallelTransform(tp, in.data() + offset, out.data() + offset, kSize, [](float x) {
+      return static_cast<double>(x) * 2;
+    });
+    EXPECT_TRUE(std::move(f).Get());
+    for (std::size_t i = offset; i != out.size(); ++i) {
+      ASSERT_EQ(out[i], static_cast<double>(i) * 2);
+    }
+  }
+  tp.Stop();
+  tp.Wait();
+}
+
+TEST(ParallelTransform, Chunk) {
+  yaclib::FairThreadPool tp{4};
+  constexpr std::size_t kSize = 1'000'003;
+  std::vector<std::uint32_t> data(kSize + 1, 1);
+  auto* begin = data.data() + 1;
+  yaclib_std::atomic_size_t chunks{0};
+  yaclib_std::atomic_size_t unaligned{0};
+  auto f = yaclib::ParallelTransform(tp, begin, begin, kSize,
+                                     [&](const std::uint32_t* in, std::uint32_t* out, std::size_t count) {
+                                       chunks.fetch_add(1, std::memory_order_relaxed);
+                                       if (reinterpret_cast<std::uintptr_t>(out) % 64 != 0) {
+                                         unaligned.fetch_add(1, std::memory_order_relaxed);
+                                       }
+                                       for (std::size_t i = 0; i != count; ++i) {
+                                         out[i] = in[i] + 1;
+                                       }
+                                     });
+  EXPECT_TRUE(std::move(f).Get());
+  EXPECT_GT(chunks.load(), 1);
+  // Only the first chunk can start in the middle of a cache line
+  EXPECT_LE(unaligned.load(), 1);
+  EXPECT_EQ(data[0], 1);
+  for (std::size_t i = 1; i != data.size(); ++i) {
+    ASSERT_EQ(data[i], 2);
+  }
+  tp.Stop();
+  tp.Wait();
+}
+
+TEST(ParallelTransform, Small) {
+  yaclib::ManualExecutor e;
+  const int in[] = {1, 2, 3};
+  int out[3] = {};
+  auto f = yaclib::ParallelTransform(e, in, out, 3, [](int x) {
+    return -x;
+  });
+  EXPECT_EQ(e.Drain(), 1);
+  EXPECT_TRUE(std::move(f).Get());
+  EXPECT_EQ(out[0], -1);
+  EXPECT_EQ(out[2], -3);
+
+  auto empty = yaclib::ParallelTransform(e, in, out, 0, [](int x) {
+    return x;
+  });
+  EXPECT_TRUE(empty.Ready());
+}
+
+TEST(ParallelTransform, Exception) {
+  yaclib::ManualExecutor e;
+  const int in[] = {1, 2, 3};
+  int out[3] = {};
+  auto f = yaclib::ParallelTransform(e, in, out, 3, [](int) -> int {
+    throw std::runtime_error{""};
+  });
+  EXPECT_EQ(e.Drain(), 1);
+  EXPECT_THROW(std::ignore = std::move(f).Get().Ok(), std::runtime_error);
+}
+
+}  // namespace
+}  // namespace test
@@ -0,0 +1,194 @@
+#include <yaclib/async/task_graph.hpp>
+#include <yaclib/exe/manual.hpp>
+#include <yaclib/runtime/fair_thread_pool.hpp>
+
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <yaclib_std/atomic>
+
+#include <gtest/gtest.h>
+
+namespace test {
+namespace {
+
+TEST(TaskGraph, Empty) {
+  yaclib::ManualExecutor e;
+  yaclib::TaskGraph graph;
+  auto f = graph.Run(e);
+  EXPECT_TRUE(f.Ready());
+  EXPECT_TRUE(std::move(f).Get());
+  EXPECT_TRUE(graph.Idle());
+}
+
+TEST(TaskGraph, Inline) {
+  yaclib::ManualExecutor e;
+  yaclib::TaskGraph graph;
+  std::vector<int> order;
+  auto a = graph.Add([&] {
+    order.push_back(0);
+  });
+  auto b = graph.Add([&] {
+    order.push_back(1);
+  });
+  auto c = graph.Add([&] {
+    order.push_back(2);
+  });
+  graph.Precede(a, b);
+  graph.Precede(b, c);
+  auto f = graph.Run(e);
+  // Every node has the only successor, which is run inline
+  EXPECT_EQ(e.Drain(), 1);
+  EXPECT_TRUE(std::move(f).Get());
+  EXPECT_EQ(order, (std::vector<int>{0, 1, 2}));
+}
+
+TEST(TaskGraph, FanOut) {
+  yaclib::ManualExecutor e;
+  yaclib::TaskGraph graph;
+  std::size_t called = 0;
+  auto root = graph.Add([&] {
+    ++called;
+  });
+  for (int i = 0; i != 3; ++i) {
+    graph.Precede(root, graph.Add([&] {
+      ++called;
+    }));
+  }
+  auto f = graph.Run(e);
+  // The last ready successor is run inline, others are submitted
+  EXPECT_EQ(e.Drain(), 3);
+  EXPECT_TRUE(std::move(f).Get());
+  EXPECT_EQ(called, 4);
+}
+
+TEST(TaskGraph, Reuse) {
+  yaclib::FairThreadPool tp{4};
+  yaclib::TaskGraph graph;
+  constexpr std::size_t kWidth = 50;
+  std::vector<yaclib_std::atomic_size_t> layer(3);
+  yaclib_std::atomic_size_t wrong{0};
+  auto source = graph.Add([&] {
+    layer[0].fetch_add(1, std::memory_order_relaxed);
+  });
+  auto sink = graph.Add([&] {
+    if (layer[1].load(std::memory_order_relaxed) % kWidth != 0) {
+      wrong.fetch_add(1, std::memory_order_relaxed);
+    }
+    layer[2].fetch_add(1, std::memory_order_relaxed);
+  });
+  for (std::size_t i = 0; i != kWidth; ++i) {
+    auto node = graph.Add([&] {
+      if (layer[0].load(std::memory_order_relaxed) != layer[2].load(std::memory_order_relaxed) + 1) {
+        wrong.fetch_add(1, std::memory_order_relaxed);
+      }
+      layer[1].fetch_add(1, std::memory_order_relaxed);
+    });
+    graph.Precede(source, node);
+    graph.Precede(node, sink);
+  }
+  constexpr std::size_t kRuns = 100;
+  for (std::size_t run = 0; run != kRuns; ++run) {
+    ASSERT_TRUE(graph.Run(tp).Get());
+    ASSERT_TRUE(graph.Idle());
+  }
+  EXPECT_EQ(wrong.load(), 0);
+  EXPECT_EQ(layer[0].load(), kRuns);
+  EXPECT_EQ(layer[1].load(), kRuns * kWidth);
+  EXPECT_EQ(layer[2].load(), kRuns);
+  tp.Stop();
+  tp.Wait();
+}
+
+TEST(TaskGraph, Exception) {
+  yaclib::ManualExecutor e;
+  yaclib::TaskGraph graph;
+  std::size_t called = 0;
+  auto a = graph.Add([&] {
+    ++called;
+    throw std::runtime_error{""};
+  });
+  auto b = graph.Add([&] {
+    ++called;
+  });
+  graph.Precede(a, b);
+  auto f = graph.Run(e);
+  EXPECT_EQ(e.Drain(), 1);
+  EXPECT_EQ(called, 1);
+  EXPECT_THROW(std::ignore = std::move(f).Get().Ok(), std::runtime_error);
+
+  // The next run starts from scratch
+  called = 0;
+  f = graph.Run(e);
+  EXPECT_EQ(e.Drain(), 1);
+  EXPECT_EQ(called, 1);
+  EXPECT_THROW(std::ignore = std::move(f).Get().Ok(), std::runtime_error);
+}
+
+TEST(TaskGraph, Cycle) {
+  yaclib::ManualExecutor e;
+  yaclib::TaskGraph graph;
+  std::size_t called = 0;
+  auto root = graph.Add([&] {
+    ++called;
+  });
+  auto a = graph.Add([&] {
+    ++called;
+  });
+  auto b = graph.Add([&] {
+    ++called;
+  });
+  graph.Precede(root, a);
+  graph.Precede(a, b);
+  graph.Precede(b, a);
+  auto f = graph.Run(e);
+  EXPECT_TRUE(f.Ready());
+  EXPECT_EQ(e.Drain(), 0);
+  EXPECT_EQ(called, 0);
+  EXPECT_THROW(std::ignore = std::move(f).Get().Ok(), yaclib::TaskGraphCycleError);
+  EXPECT_TRUE(graph.Idle());
+
+  // Every node is in the cycle, so there are no roots at all
+  yaclib::TaskGraph ring;
+  auto x = ring.Add([] {
+  });
+  auto y = ring.Add([] {
+  });
+  ring.Precede(x, y);
+  ring.Precede(y, x);
+  EXPECT_THROW(std::ignore = ring.Run(e).Get().Ok(), yaclib::TaskGraphCycleError);
+}
+
+TEST(TaskGraph, Cancel) {
+  yaclib::ManualExecutor e;
+  yaclib::TaskGraph graph;
+  std::size_t called = 0;
+  graph.Add([&] {
+    ++called;
+  });
+  graph.Run(e).Cancel();
+  EXPECT_EQ(e.Drain(), 1);
+  EXPECT_EQ(called, 0);
+  EXPECT_TRUE(graph.Idle());
+}
+
+TEST(TaskGraph, Stop) {
+  yaclib::FairThreadPool tp{1};
+  tp.Stop();
+  yaclib::TaskGraph graph;
+  std::size_t called = 0;
+  auto a = graph.Add([&] {
+    ++called;
+  });
+  graph.Precede(a, graph.Add([&] {
+    ++called;
+  }));
+  EXPECT_EQ(graph.Run(tp).Get().Error(), yaclib::StopError{yaclib::StopTag{}});
+  EXPECT_EQ(called, 0);
+  tp.Wait();
+}
+
+}  // namespace
+}  // namespace test
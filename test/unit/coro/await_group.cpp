@@ -7,10 +7,13 @@
 #include <yaclib/coro/current_executor.hpp>
 #include <yaclib/coro/future.hpp>
 #include <yaclib/coro/on.hpp>
+#include <yaclib/exe/executor.hpp>
 #include <yaclib/exe/manual.hpp>
 #include <yaclib/runtime/fair_thread_pool.hpp>
+#include <yaclib/util/detail/intrusive_list.hpp>
 
 #include <array>
+#include <cstddef>
 #include <exception>
 #include <stack>
 #include <utility>
@@ -102,6 +105,54 @@ TEST(AwaitEvent, JustCall) {
   tp.Wait();
 }
 
+TEST(AwaitEvent, StickyBatch) {
+  class BatchExecutor final : public yaclib::IExecutor {
+   public:
+    [[nodiscard]] Type Tag() const noexcept final {
+      return Type::Custom;
+    }
+
+    [[nodiscard]] bool Alive() const noexcept final {
+      return true;
+    }
+
+    void Submit(yaclib::Job& job) noexcept final {
+      ++submits;
+      manual.Submit(job);
+    }
+
+    void SubmitBatch(yaclib::detail::List& jobs, std::size_t count) noexcept final {
+      ++batches;
+      manual.SubmitBatch(jobs, count);
+    }
+
+    yaclib::ManualExecutor manual;
+    std::size_t submits = 0;
+    std::size_t batches = 0;
+  };
+  static constexpr std::size_t kWaiters = 10;
+  BatchExecutor e;
+  yaclib::OneShotEvent event;
+  std::size_t resumed = 0;
+  auto waiter = [&]() -> yaclib::Future<> {
+    co_await On(e);
+    co_await event.AwaitSticky();
+    ++resumed;
+    co_return{};
+  };
+  for (std::size_t i = 0; i != kWaiters; ++i) {
+    std::ignore = waiter();
+  }
+  EXPECT_EQ(e.manual.Drain(), kWaiters);
+  e.submits = 0;
+  event.Set();
+  EXPECT_EQ(e.submits, 0);
+  EXPECT_EQ(e.batches, 1);
+  EXPECT_EQ(resumed, 0);
+  EXPECT_EQ(e.manual.Drain(), kWaiters);
+  EXPECT_EQ(resumed, kWaiters);
+}
+
 TEST(AwaitGroup, OneWaiter) {
   auto manual = yaclib::MakeManual();
 
@@ -0,0 +1,93 @@
+#include <yaclib/async/wait.hpp>
+#include <yaclib/coro/barrier.hpp>
+#include <yaclib/coro/future.hpp>
+#include <yaclib/coro/on.hpp>
+#include <yaclib/exe/manual.hpp>
+#include <yaclib/runtime/fair_thread_pool.hpp>
+
+#include <cstddef>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace test {
+namespace {
+
+TEST(AsyncBarrier, BatchResume) {
+  yaclib::ManualExecutor manual;
+  std::size_t completed = 0;
+  yaclib::AsyncBarrier barrier{3, [&]() noexcept {
+                                 ++completed;
+                               }};
+  std::size_t passed = 0;
+  auto participant = [&]() -> yaclib::Future<> {
+    co_await On(manual);
+    EXPECT_EQ(co_await barrier.ArriveAndWait(), 0);
+    ++passed;
+    EXPECT_EQ(co_await barrier.ArriveAndWait(), 1);
+    co_return{};
+  };
+  std::vector<yaclib::Future<>> futures;
+  for (std::size_t i = 0; i != 3; ++i) {
+    futures.push_back(participant());
+  }
+  // In every phase the last participant continues, and two others are submitted by the batch
+  EXPECT_EQ(manual.Drain(), 3 + 2 + 2);
+  EXPECT_EQ(completed, 2);
+  EXPECT_EQ(passed, 3);
+  EXPECT_EQ(barrier.Phase(), 2);
+  for (auto& f : futures) {
+    EXPECT_TRUE(f.Ready());
+  }
+}
+
+TEST(AsyncBarrier, ArriveAndDrop) {
+  yaclib::AsyncBarrier barrier{2};
+  auto participant = [&]() -> yaclib::Future<std::size_t> {
+    auto first = co_await barrier.ArriveAndWait();
+    auto second = co_await barrier.ArriveAndWait();
+    co_return first + second;
+  };
+  auto f = participant();
+  EXPECT_FALSE(f.Ready());
+  // Completes the first phase, the second phase waits only for one participant
+  barrier.ArriveAndDrop();
+  EXPECT_TRUE(f.Ready());
+  EXPECT_EQ(std::move(f).Get().Ok(), 1);
+}
+
+TEST(AsyncBarrier, Rounds) {
+  yaclib::FairThreadPool tp{4};
+  constexpr std::size_t kWorkers = 8;
+  constexpr std::size_t kRounds = 100;
+  std::vector<std::size_t> values(kWorkers, 0);
+  std::size_t rounds = 0;
+  yaclib::AsyncBarrier barrier{kWorkers, [&]() noexcept {
+                                 // Every worker made the same number of steps
+                                 for (auto value : values) {
+                                   EXPECT_EQ(value, rounds + 1);
+                                 }
+                                 ++rounds;
+                               }};
+  auto worker = [&](std::size_t index) -> yaclib::Future<> {
+    co_await On(tp);
+    for (std::size_t i = 0; i != kRounds; ++i) {
+      ++values[index];
+      EXPECT_EQ(co_await barrier.ArriveAndWait(), i);
+      // The completion is done before the next phase
+      EXPECT_EQ(rounds, i + 1);
+    }
+    co_return{};
+  };
+  std::vector<yaclib::Future<>> futures;
+  for (std::size_t i = 0; i != kWorkers; ++i) {
+    futures.push_back(worker(i));
+  }
+  yaclib::Wait(futures.begin(), futures.end());
+  EXPECT_EQ(rounds, kRounds);
+  tp.Stop();
+  tp.Wait();
+}
+
+}  // namespace
+}  // namespace test
@@ -0,0 +1,149 @@
+#include <yaclib/async/wait.hpp>
+#include <yaclib/coro/channel.hpp>
+#include <yaclib/coro/future.hpp>
+#include <yaclib/coro/on.hpp>
+#include <yaclib/runtime/fair_thread_pool.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <utility>
+#include <vector>
+#include <yaclib_std/atomic>
+
+#include <gtest/gtest.h>
+
+namespace test {
+namespace {
+
+TEST(Channel, Buffer) {
+  yaclib::Channel<int> channel{2};
+  std::size_t sent = 0;
+  auto producer = [&]() -> yaclib::Future<> {
+    for (int i = 0; i != 3; ++i) {
+      EXPECT_TRUE(co_await channel.Send(i));
+      ++sent;
+    }
+    co_return{};
+  };
+  auto f = producer();
+  // The third value waits for the free slot
+  EXPECT_EQ(sent, 2);
+  EXPECT_FALSE(f.Ready());
+  EXPECT_EQ(channel.TryRecv(), 0);
+  EXPECT_TRUE(f.Ready());
+  EXPECT_EQ(channel.TryRecv(), 1);
+  EXPECT_EQ(channel.TryRecv(), 2);
+  EXPECT_EQ(channel.TryRecv(), std::nullopt);
+}
+
+TEST(Channel, RecvWait) {
+  yaclib::Channel<int> channel{4};
+  std::vector<int> received;
+  auto consumer = [&]() -> yaclib::Future<> {
+    while (auto value = co_await channel.Recv()) {
+      received.push_back(*value);
+    }
+    co_return{};
+  };
+  auto f = consumer();
+  EXPECT_TRUE(channel.TrySend(1));
+  EXPECT_TRUE(channel.TrySend(2));
+  EXPECT_EQ(received, (std::vector<int>{1, 2}));
+  EXPECT_FALSE(f.Ready());
+  channel.Close();
+  EXPECT_TRUE(f.Ready());
+  EXPECT_FALSE(channel.TrySend(3));
+}
+
+TEST(Channel, Close) {
+  yaclib::Channel<int> channel{1};
+  EXPECT_TRUE(channel.TrySend(1));
+  auto producer = [&]() -> yaclib::Future<bool> {
+    co_return co_await channel.Send(2);
+  };
+  auto f = producer();
+  EXPECT_FALSE(f.Ready());
+  channel.Close();
+  EXPECT_TRUE(channel.Closed());
+  EXPECT_FALSE(std::move(f).Get().Ok());
+  // Values which are already in the buffer are still received
+  auto consumer = [&]() -> yaclib::Future<std::optional<int>> {
+    EXPECT_EQ(co_await channel.Recv(), 1);
+    co_return co_await channel.Recv();
+  };
+  EXPECT_EQ(consumer().Get().Ok(), std::nullopt);
+}
+
+TEST(Channel, Unbuffered) {
+  yaclib::Channel<int> channel{0};
+  EXPECT_FALSE(channel.TrySend(1));
+  auto producer = [&]() -> yaclib::Future<> {
+    EXPECT_TRUE(co_await channel.Send(1));
+    co_return{};
+  };
+  auto f = producer();
+  EXPECT_FALSE(f.Ready());
+  EXPECT_EQ(channel.TryRecv(), 1);
+  EXPECT_TRUE(f.Ready());
+}
+
+TEST(Channel, TryRecvMany) {
+  yaclib::Channel<int> channel{4};
+  for (int i = 0; i != 4; ++i) {
+    EXPECT_TRUE(channel.TrySend(i));
+  }
+  EXPECT_FALSE(channel.TrySend(4));
+  auto producer = [&]() -> yaclib::Future<> {
+    EXPECT_TRUE(co_await channel.Send(4));
+    co_return{};
+  };
+  auto f = producer();
+  std::vector<int> values;
+  EXPECT_EQ(channel.TryRecvMany(std::back_inserter(values), 3), 3);
+  // The waiting sender takes a free slot
+  EXPECT_TRUE(f.Ready());
+  EXPECT_EQ(channel.TryRecvMany(std::back_inserter(values), 10), 2);
+  EXPECT_EQ(values, (std::vector<int>{0, 1, 2, 3, 4}));
+}
+
+TEST(Channel, MPMC) {
+  yaclib::FairThreadPool tp{4};
+  yaclib::Channel<std::size_t> channel{8};
+  constexpr std::size_t kProducers = 4;
+  constexpr std::size_t kConsumers = 4;
+  constexpr std::size_t kValues = 10'000;
+  yaclib_std::atomic_size_t sum{0};
+  yaclib_std::atomic_size_t producers{kProducers};
+  auto producer = [&]() -> yaclib::Future<> {
+    co_await On(tp);
+    for (std::size_t i = 1; i <= kValues; ++i) {
+      EXPECT_TRUE(co_await channel.Send(i));
+    }
+    if (producers.fetch_sub(1) == 1) {
+      channel.Close();
+    }
+    co_return{};
+  };
+  auto consumer = [&]() -> yaclib::Future<> {
+    co_await On(tp);
+    while (auto value = co_await channel.Recv()) {
+      sum.fetch_add(*value, std::memory_order_relaxed);
+    }
+    co_return{};
+  };
+  std::vector<yaclib::Future<>> futures;
+  for (std::size_t i = 0; i != kConsumers; ++i) {
+    futures.push_back(consumer());
+  }
+  for (std::size_t i = 0; i != kProducers; ++i) {
+    futures.push_back(producer());
+  }
+  yaclib::Wait(futures.begin(), futures.end());
+  EXPECT_EQ(sum.load(), kProducers * kValues * (kValues + 1) / 2);
+  tp.Stop();
+  tp.Wait();
+}
+
+}  // namespace
+}  // namespace test
@@ -0,0 +1,136 @@
+#include <yaclib/async/wait.hpp>
+#include <yaclib/coro/condition_variable.hpp>
+#include <yaclib/coro/future.hpp>
+#include <yaclib/coro/mutex.hpp>
+#include <yaclib/coro/on.hpp>
+#include <yaclib/runtime/fair_thread_pool.hpp>
+
+#include <cstddef>
+#include <deque>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace test {
+namespace {
+
+TEST(AsyncConditionVariable, NotifyUnderLock) {
+  yaclib::Mutex<> m;
+  yaclib::AsyncConditionVariable<> cv;
+  bool ready = false;
+  std::size_t done = 0;
+  auto waiter = [&]() -> yaclib::Future<> {
+    auto guard = co_await m.Guard();
+    while (!ready) {
+      co_await cv.Wait(guard);
+    }
+    EXPECT_TRUE(guard.OwnsLock());
+    ++done;
+    co_return{};
+  };
+  auto notifier = [&]() -> yaclib::Future<> {
+    auto guard = co_await m.Guard();
+    ready = true;
+    cv.NotifyAll();
+    // Waiters are moved to the mutex, so they wait for unlock
+    EXPECT_EQ(done, 0);
+    co_return{};
+  };
+  std::vector<yaclib::Future<>> waiters;
+  for (std::size_t i = 0; i != 3; ++i) {
+    waiters.push_back(waiter());
+  }
+  EXPECT_EQ(done, 0);
+  EXPECT_TRUE(m.TryLock());
+  m.UnlockHere();
+  auto f = notifier();
+  EXPECT_TRUE(f.Ready());
+  EXPECT_EQ(done, 3);
+  EXPECT_TRUE(m.TryLock());
+  m.UnlockHere();
+}
+
+TEST(AsyncConditionVariable, NotifyOne) {
+  yaclib::Mutex<> m;
+  yaclib::AsyncConditionVariable<> cv;
+  std::size_t tokens = 0;
+  std::size_t done = 0;
+  auto waiter = [&]() -> yaclib::Future<> {
+    auto guard = co_await m.Guard();
+    while (tokens == 0) {
+      co_await cv.Wait(guard);
+    }
+    --tokens;
+    ++done;
+    co_return{};
+  };
+  auto f1 = waiter();
+  auto f2 = waiter();
+  // Notify without the lock resumes the waiter, because the mutex is free
+  ++tokens;
+  cv.NotifyOne();
+  EXPECT_EQ(done, 1);
+  cv.NotifyOne();
+  EXPECT_EQ(done, 1);
+  ++tokens;
+  cv.NotifyOne();
+  EXPECT_EQ(done, 2);
+  EXPECT_TRUE(f1.Ready());
+  EXPECT_TRUE(f2.Ready());
+}
+
+TEST(AsyncConditionVariable, Queue) {
+  yaclib::FairThreadPool tp{4};
+  yaclib::Mutex<> m;
+  yaclib::AsyncConditionVariable<> cv;
+  std::deque<std::size_t> queue;
+  bool closed = false;
+  constexpr std::size_t kValues = 10'000;
+  constexpr std::size_t kConsumers = 4;
+  auto producer = [&]() -> yaclib::Future<> {
+    co_await On(tp);
+    for (std::size_t i = 1; i <= kValues; ++i) {
+      auto guard = co_await m.Guard();
+      queue.push_back(i);
+      cv.NotifyOne();
+    }
+    auto guard = co_await m.Guard();
+    closed = true;
+    cv.NotifyAll();
+    co_return{};
+  };
+  auto consumer = [&]() -> yaclib::Future<std::size_t> {
+    co_await On(tp);
+    std::size_t sum = 0;
+    auto guard = co_await m.Guard();
+    while (true) {
+      while (queue.empty() && !closed) {
+        co_await cv.Wait(guard);
+      }
+      if (queue.empty()) {
+        break;
+      }
+      sum += queue.front();
+      queue.pop_front();
+    }
+    co_return sum;
+  };
+  std::vector<yaclib::Future<std::size_t>> consumers;
+  for (std::size_t i = 0; i != kConsumers; ++i) {
+    consumers.push_back(consumer());
+  }
+  auto f = producer();
+  yaclib::Wait(consumers.begin(), consumers.end());
+  std::size_t sum = 0;
+  for (auto& consumer : consumers) {
+    sum += std::move(consumer).Get().Ok();
+  }
+  EXPECT_EQ(sum, kValues * (kValues + 1) / 2);
+  yaclib::Wait(f);
+  tp.Stop();
+  tp.Wait();
+}
+
+}  // namespace
+}  // namespace test
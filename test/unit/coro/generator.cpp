@@ -0,0 +1,163 @@
+#include <yaclib/coro/future.hpp>
+#include <yaclib/coro/generator.hpp>
+#include <yaclib/coro/on.hpp>
+#include <yaclib/runtime/fair_thread_pool.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace test {
+namespace {
+
+yaclib::AsyncGenerator<int> Iota(int n, std::size_t& started) {
+  ++started;
+  for (int i = 0; i != n; ++i) {
+    co_yield int{i};
+  }
+}
+
+TEST(AsyncGenerator, Sequence) {
+  std::size_t started = 0;
+  auto consumer = [&]() -> yaclib::Future<std::vector<int>> {
+    auto generator = Iota(5, started);
+    // Generator is lazy
+    EXPECT_EQ(started, 0);
+    std::vector<int> values;
+    while (auto value = co_await generator.Next()) {
+      values.push_back(*value);
+    }
+    // Finished generator stays finished
+    EXPECT_EQ(co_await generator.Next(), std::nullopt);
+    co_return values;
+  };
+  EXPECT_EQ(consumer().Get().Ok(), (std::vector<int>{0, 1, 2, 3, 4}));
+  EXPECT_EQ(started, 1);
+}
+
+TEST(AsyncGenerator, LongStream) {
+  // Stack doesn't grow with the count of elements without symmetric transfer.
+  // Symmetric transfer is a tail call only if the compiler optimizes it, so it's checked on a shorter stream
+#if YACLIB_SYMMETRIC_TRANSFER != 0
+  constexpr int kCount = 10'000;
+#else
+  constexpr int kCount = 1'000'000;
+#endif
+  std::size_t started = 0;
+  auto consumer = [&]() -> yaclib::Future<std::size_t> {
+    auto generator = Iota(kCount, started);
+    std::size_t sum = 0;
+    while (auto value = co_await generator.Next()) {
+      sum += static_cast<std::size_t>(*value);
+    }
+    co_return sum;
+  };
+  EXPECT_EQ(consumer().Get().Ok(), std::size_t{kCount} * (kCount - 1) / 2);
+}
+
+TEST(AsyncGenerator, MoveAndCopy) {
+  auto pointers = []() -> yaclib::AsyncGenerator<std::unique_ptr<int>> {
+    for (int i = 0; i != 3; ++i) {
+      co_yield std::make_unique<int>(i);
+    }
+  };
+  std::string text = "text";
+  auto strings = [&]() -> yaclib::AsyncGenerator<std::string> {
+    co_yield text;
+    co_yield text;
+  };
+  auto consumer = [&]() -> yaclib::Future<int> {
+    int sum = 0;
+    auto generator = pointers();
+    while (auto value = co_await generator.Next()) {
+      sum += **value;
+    }
+    auto copies = strings();
+    while (auto value = co_await copies.Next()) {
+      EXPECT_EQ(*value, "text");
+    }
+    co_return sum;
+  };
+  EXPECT_EQ(consumer().Get().Ok(), 3);
+  // lvalue is copied
+  EXPECT_EQ(text, "text");
+}
+
+TEST(AsyncGenerator, Exception) {
+  auto generator = []() -> yaclib::AsyncGenerator<int> {
+    co_yield 1;
+    throw std::runtime_error{""};
+  };
+  auto consumer = [&]() -> yaclib::Future<int> {
+    auto g = generator();
+    auto value = co_await g.Next();
+    EXPECT_EQ(value, 1);
+    EXPECT_THROW(std::ignore = co_await g.Next(), std::runtime_error);
+    EXPECT_EQ(co_await g.Next(), std::nullopt);
+    co_return *value;
+  };
+  EXPECT_EQ(consumer().Get().Ok(), 1);
+}
+
+TEST(AsyncGenerator, DestroySuspended) {
+  std::size_t destroyed = 0;
+  auto generator = [&]() -> yaclib::AsyncGenerator<int> {
+    std::shared_ptr<void> guard{nullptr, [&](void*) {
+                                  ++destroyed;
+                                }};
+    for (int i = 0;; ++i) {
+      co_yield int{i};
+    }
+  };
+  auto consumer = [&]() -> yaclib::Future<int> {
+    auto g = generator();
+    int sum = 0;
+    for (int i = 0; i != 3; ++i) {
+      sum += *co_await g.Next();
+    }
+    co_return sum;
+  };
+  EXPECT_EQ(consumer().Get().Ok(), 3);
+  EXPECT_EQ(destroyed, 1);
+}
+
+TEST(AsyncGenerator, OtherExecutor) {
+  yaclib::FairThreadPool producers{1};
+  yaclib::FairThreadPool consumers{1};
+  auto generator = [&]() -> yaclib::AsyncGenerator<std::thread::id> {
+    co_await On(producers);
+    for (int i = 0; i != 3; ++i) {
+      co_yield std::this_thread::get_id();
+    }
+  };
+  auto consumer = [&]() -> yaclib::Future<> {
+    co_await On(consumers);
+    const auto consumer_id = std::this_thread::get_id();
+    auto g = generator();
+    std::size_t count = 0;
+    while (auto id = co_await g.Next()) {
+      // Values are produced on the producer executor, but received on the consumer executor
+      EXPECT_NE(*id, consumer_id);
+      EXPECT_EQ(std::this_thread::get_id(), consumer_id);
+      ++count;
+    }
+    EXPECT_EQ(count, 3);
+    co_return{};
+  };
+  EXPECT_EQ(consumer().Get().State(), yaclib::ResultState::Value);
+  producers.Stop();
+  producers.Wait();
+  consumers.Stop();
+  consumers.Wait();
+}
+
+}  // namespace
+}  // namespace test
@@ -0,0 +1,59 @@
+#include <yaclib/async/wait.hpp>
+#include <yaclib/coro/future.hpp>
+#include <yaclib/coro/latch.hpp>
+#include <yaclib/coro/on.hpp>
+#include <yaclib/runtime/fair_thread_pool.hpp>
+
+#include <cstddef>
+#include <vector>
+#include <yaclib_std/atomic>
+
+#include <gtest/gtest.h>
+
+namespace test {
+namespace {
+
+TEST(AsyncLatch, CountDown) {
+  yaclib::AsyncLatch latch{2};
+  std::size_t done = 0;
+  auto waiter = [&]() -> yaclib::Future<> {
+    co_await latch.Wait();
+    ++done;
+    co_return{};
+  };
+  auto f1 = waiter();
+  auto f2 = waiter();
+  EXPECT_FALSE(latch.TryWait());
+  latch.CountDown();
+  EXPECT_EQ(done, 0);
+  latch.CountDown();
+  EXPECT_TRUE(latch.TryWait());
+  EXPECT_EQ(done, 2);
+  // Latch is opened forever
+  auto f3 = waiter();
+  EXPECT_TRUE(f3.Ready());
+}
+
+TEST(AsyncLatch, ArriveAndWait) {
+  yaclib::FairThreadPool tp{4};
+  constexpr std::size_t kWorkers = 8;
+  yaclib::AsyncLatch latch{kWorkers};
+  yaclib_std::atomic_size_t arrived{0};
+  auto worker = [&]() -> yaclib::Future<> {
+    co_await On(tp);
+    arrived.fetch_add(1);
+    co_await latch.ArriveAndWait();
+    EXPECT_EQ(arrived.load(), kWorkers);
+    co_return{};
+  };
+  std::vector<yaclib::Future<>> futures;
+  for (std::size_t i = 0; i != kWorkers; ++i) {
+    futures.push_back(worker());
+  }
+  yaclib::Wait(futures.begin(), futures.end());
+  tp.Stop();
+  tp.Wait();
+}
+
+}  // namespace
+}  // namespace test
@@ -0,0 +1,104 @@
+#include <yaclib/async/wait.hpp>
+#include <yaclib/coro/future.hpp>
+#include <yaclib/coro/on.hpp>
+#include <yaclib/coro/pool.hpp>
+#include <yaclib/runtime/fair_thread_pool.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <yaclib_std/atomic>
+
+#include <gtest/gtest.h>
+
+namespace test {
+namespace {
+
+TEST(AsyncPool, LazyCreation) {
+  std::size_t created = 0;
+  yaclib::AsyncPool pool{2, [&] {
+                           return ++created;
+                         }};
+  auto first = pool.TryAcquire();
+  EXPECT_TRUE(first);
+  EXPECT_EQ(*first, 1);
+  first.Release();
+  // Created object is reused
+  auto second = pool.TryAcquire();
+  EXPECT_EQ(*second, 1);
+  auto third = pool.TryAcquire();
+  EXPECT_EQ(*third, 2);
+  EXPECT_FALSE(pool.TryAcquire());
+  EXPECT_EQ(created, 2);
+}
+
+TEST(AsyncPool, Handoff) {
+  yaclib::AsyncPool pool{1, [] {
+                           return std::make_unique<int>(1);
+                         }};
+  auto lease = pool.TryAcquire();
+  ASSERT_TRUE(lease);
+  auto* object = lease->get();
+  auto waiter = [&]() -> yaclib::Future<int*> {
+    auto next = co_await pool.Acquire();
+    co_return next->get();
+  };
+  auto f = waiter();
+  EXPECT_FALSE(f.Ready());
+  lease.Release();
+  EXPECT_TRUE(f.Ready());
+  EXPECT_EQ(std::move(f).Get().Ok(), object);
+  EXPECT_TRUE(pool.TryAcquire());
+}
+
+TEST(AsyncPool, FactoryThrows) {
+  std::size_t calls = 0;
+  yaclib::AsyncPool pool{1, [&] {
+                           if (++calls == 1) {
+                             throw std::runtime_error{""};
+                           }
+                           return calls;
+                         }};
+  auto acquire = [&]() -> yaclib::Future<std::size_t> {
+    auto lease = co_await pool.Acquire();
+    co_return *lease;
+  };
+  EXPECT_THROW(std::ignore = acquire().Get().Ok(), std::runtime_error);
+  // The slot is returned, so the object is created by the next Acquire
+  EXPECT_EQ(acquire().Get().Ok(), 2);
+}
+
+TEST(AsyncPool, Exclusive) {
+  struct Object {
+    yaclib_std::atomic_bool busy{false};
+  };
+  yaclib::FairThreadPool tp{4};
+  constexpr std::size_t kCapacity = 3;
+  yaclib::AsyncPool pool{kCapacity, [] {
+                           return std::make_unique<Object>();
+                         }};
+  yaclib_std::atomic_size_t in_use{0};
+  auto worker = [&]() -> yaclib::Future<> {
+    co_await On(tp);
+    for (std::size_t i = 0; i != 500; ++i) {
+      auto lease = co_await pool.Acquire();
+      EXPECT_FALSE((*lease)->busy.exchange(true));
+      EXPECT_LE(in_use.fetch_add(1) + 1, kCapacity);
+      in_use.fetch_sub(1);
+      (*lease)->busy.store(false);
+    }
+    co_return{};
+  };
+  std::vector<yaclib::Future<>> futures;
+  for (std::size_t i = 0; i != 16; ++i) {
+    futures.push_back(worker());
+  }
+  yaclib::Wait(futures.begin(), futures.end());
+  tp.Stop();
+  tp.Wait();
+}
+
+}  // namespace
+}  // namespace test
@@ -0,0 +1,134 @@
+#include <yaclib/async/wait.hpp>
+#include <yaclib/coro/future.hpp>
+#include <yaclib/coro/on.hpp>
+#include <yaclib/coro/semaphore.hpp>
+#include <yaclib/exe/manual.hpp>
+#include <yaclib/runtime/fair_thread_pool.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <yaclib_std/atomic>
+
+#include <gtest/gtest.h>
+
+namespace test {
+namespace {
+
+TEST(AsyncSemaphore, Try) {
+  yaclib::AsyncSemaphore semaphore{3};
+  EXPECT_TRUE(semaphore.TryAcquire(2));
+  EXPECT_FALSE(semaphore.TryAcquire(2));
+  EXPECT_TRUE(semaphore.TryAcquire());
+  EXPECT_EQ(semaphore.Available(), 0);
+  semaphore.Release(3);
+  EXPECT_EQ(semaphore.Available(), 3);
+}
+
+TEST(AsyncSemaphore, WeightedFIFO) {
+  yaclib::AsyncSemaphore semaphore{2};
+  auto acquire = [&](std::uint64_t n) -> yaclib::Future<> {
+    co_await semaphore.Acquire(n);
+    co_return{};
+  };
+  auto big = acquire(3);
+  EXPECT_FALSE(big.Ready());
+  // Permits are available, but the small request waits behind the big one
+  auto small = acquire(1);
+  EXPECT_FALSE(small.Ready());
+  EXPECT_FALSE(semaphore.TryAcquire());
+  semaphore.Release();
+  EXPECT_TRUE(big.Ready());
+  EXPECT_FALSE(small.Ready());
+  semaphore.Release();
+  EXPECT_TRUE(small.Ready());
+  EXPECT_EQ(semaphore.Available(), 0);
+  semaphore.Release(4);
+  EXPECT_EQ(semaphore.Available(), 4);
+}
+
+TEST(AsyncSemaphore, BatchResume) {
+  yaclib::ManualExecutor manual;
+  yaclib::AsyncSemaphore semaphore{0};
+  std::size_t acquired = 0;
+  auto acquire = [&]() -> yaclib::Future<> {
+    co_await On(manual);
+    co_await semaphore.Acquire();
+    ++acquired;
+    co_return{};
+  };
+  std::vector<yaclib::Future<>> futures;
+  for (std::size_t i = 0; i != 4; ++i) {
+    futures.push_back(acquire());
+  }
+  EXPECT_EQ(manual.Drain(), 4);
+  EXPECT_EQ(acquired, 0);
+  semaphore.Release(3);
+  // All waiters which got permits are submitted together
+  EXPECT_EQ(manual.Drain(), 3);
+  EXPECT_EQ(acquired, 3);
+  semaphore.Release();
+  EXPECT_EQ(manual.Drain(), 1);
+  EXPECT_EQ(acquired, 4);
+}
+
+TEST(AsyncSemaphore, Limit) {
+  yaclib::FairThreadPool tp{4};
+  constexpr std::uint64_t kPermits = 3;
+  yaclib::AsyncSemaphore semaphore{kPermits};
+  yaclib_std::atomic_uint64_t in_use{0};
+  auto worker = [&](std::uint64_t n) -> yaclib::Future<> {
+    co_await On(tp);
+    for (std::size_t i = 0; i != 1000; ++i) {
+      co_await semaphore.Acquire(n);
+      EXPECT_LE(in_use.fetch_add(n) + n, kPermits);
+      in_use.fetch_sub(n);
+      semaphore.Release(n);
+    }
+    co_return{};
+  };
+  std::vector<yaclib::Future<>> futures;
+  for (std::uint64_t i = 0; i != 8; ++i) {
+    futures.push_back(worker(i % kPermits + 1));
+  }
+  yaclib::Wait(futures.begin(), futures.end());
+  EXPECT_EQ(semaphore.Available(), kPermits);
+  tp.Stop();
+  tp.Wait();
+}
+
+TEST(AsyncSemaphore, MixedTryAcquire) {
+  yaclib::FairThreadPool tp{4};
+  constexpr std::uint64_t kPermits = 2;
+  yaclib::AsyncSemaphore semaphore{kPermits};
+  auto waiter = [&](std::uint64_t n) -> yaclib::Future<> {
+    co_await On(tp);
+    for (std::size_t i = 0; i != 1000; ++i) {
+      co_await semaphore.Acquire(n);
+      semaphore.Release(n);
+    }
+    co_return{};
+  };
+  // Lock-free paths race with the release which serves the last waiter
+  auto trier = [&]() -> yaclib::Future<> {
+    co_await On(tp);
+    for (std::size_t i = 0; i != 10000; ++i) {
+      if (semaphore.TryAcquire()) {
+        semaphore.Release();
+      }
+    }
+    co_return{};
+  };
+  std::vector<yaclib::Future<>> futures;
+  for (std::uint64_t i = 0; i != 4; ++i) {
+    futures.push_back(waiter(i % kPermits + 1));
+    futures.push_back(trier());
+  }
+  yaclib::Wait(futures.begin(), futures.end());
+  EXPECT_EQ(semaphore.Available(), kPermits);
+  tp.Stop();
+  tp.Wait();
+}
+
+}  // namespace
+}  // namespace test
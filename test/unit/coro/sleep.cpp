@@ -0,0 +1,85 @@
+#include <yaclib/async/wait.hpp>
+#include <yaclib/coro/current_executor.hpp>
+#include <yaclib/coro/future.hpp>
+#include <yaclib/coro/on.hpp>
+#include <yaclib/runtime/fair_thread_pool.hpp>
+#include <yaclib/runtime/timer_service.hpp>
+
+#include <chrono>
+#include <utility>
+#include <vector>
+#include <yaclib_std/atomic>
+
+#include <gtest/gtest.h>
+
+namespace test {
+namespace {
+
+using namespace std::chrono_literals;
+using Clock = yaclib::TimerService::Clock;
+
+TEST(Sleep, JustWorks) {
+  yaclib::TimerService timer;
+  yaclib::FairThreadPool tp{2};
+  auto coro = [&]() -> yaclib::Future<> {
+    co_await On(tp);
+    const auto start = Clock::now();
+    co_await timer.SleepFor(10ms);
+    EXPECT_GE(Clock::now() - start, 10ms);
+    EXPECT_EQ(&co_await yaclib::CurrentExecutor(), &tp);
+    co_await timer.SleepUntil(Clock::now() - 1s);
+    co_return{};
+  };
+  EXPECT_TRUE(coro().Get().Ok() == yaclib::Unit{});
+  timer.Stop();
+  timer.Wait();
+  tp.Stop();
+  tp.Wait();
+}
+
+TEST(Sleep, ManyCoros) {
+  yaclib::TimerService timer;
+  yaclib::FairThreadPool tp{2};
+  yaclib_std::atomic_int32_t sum{0};
+  auto coro = [&](int a) -> yaclib::Future<> {
+    co_await On(tp);
+    co_await timer.SleepFor(std::chrono::milliseconds{a % 7});
+    sum.fetch_add(a, std::memory_order_relaxed);
+    co_return{};
+  };
+  constexpr int kCoros = 100;
+  std::vector<yaclib::Future<>> futures;
+  for (int i = 0; i != kCoros; ++i) {
+    futures.push_back(coro(i));
+  }
+  yaclib::Wait(futures.begin(), futures.size());
+  EXPECT_EQ(sum.load(), kCoros * (kCoros - 1) / 2);
+  timer.Stop();
+  timer.Wait();
+  tp.Stop();
+  tp.Wait();
+}
+
+TEST(Sleep, Stop) {
+  yaclib::TimerService timer;
+  yaclib::FairThreadPool tp{1};
+  yaclib_std::atomic_bool resumed{false};
+  auto coro = [&]() -> yaclib::Future<> {
+    co_await On(tp);
+    co_await timer.SleepFor(1h);
+    resumed = true;
+    co_return{};
+  };
+  auto f = coro();
+  while (!f.Ready()) {
+    timer.Stop();
+  }
+  EXPECT_EQ(std::move(f).Get().State(), yaclib::ResultState::Error);
+  EXPECT_FALSE(resumed.load());
+  timer.Wait();
+  tp.Stop();
+  tp.Wait();
+}
+
+}  // namespace
+}  // namespace test
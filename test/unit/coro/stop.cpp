@@ -0,0 +1,64 @@
+#include <yaclib/async/contract.hpp>
+#include <yaclib/coro/await.hpp>
+#include <yaclib/coro/future.hpp>
+#include <yaclib/coro/on.hpp>
+#include <yaclib/coro/stop.hpp>
+#include <yaclib/exe/manual.hpp>
+
+#include <utility>
+
+#include <gtest/gtest.h>
+
+namespace test {
+namespace {
+
+TEST(Stop, NotRequested) {
+  yaclib::ManualExecutor e;
+  bool reached = false;
+  auto coro = [&]() -> yaclib::Future<int> {
+    co_await On(e);
+    EXPECT_FALSE(co_await yaclib::StopRequested());
+    co_await yaclib::StopPoint();
+    reached = true;
+    co_return 1;
+  };
+  auto f = coro();
+  std::ignore = e.Drain();
+  EXPECT_TRUE(reached);
+  EXPECT_EQ(std::move(f).Get().Ok(), 1);
+}
+
+TEST(Stop, Point) {
+  yaclib::ManualExecutor e;
+  bool requested = false;
+  bool reached = false;
+  auto coro = [&]() -> yaclib::Future<int> {
+    co_await On(e);
+    requested = co_await yaclib::StopRequested();
+    co_await yaclib::StopPoint();
+    reached = true;
+    co_return 1;
+  };
+  auto f = coro();
+  std::move(f).Cancel();
+  std::ignore = e.Drain();
+  EXPECT_TRUE(requested);
+  EXPECT_FALSE(reached);
+}
+
+TEST(Stop, Propagation) {
+  // Coroutine is the callback of the future, so stop goes through it to the promise
+  auto [f, p] = yaclib::MakeContract<int>();
+  auto coro = [&](yaclib::Future<int> f) -> yaclib::Future<int> {
+    co_await Await(f);
+    co_return std::move(f).Touch().Ok() + 1;
+  };
+  auto g = coro(std::move(f));
+  EXPECT_FALSE(p.StopRequested());
+  std::move(g).Cancel();
+  EXPECT_TRUE(p.StopRequested());
+  std::move(p).Set(1);
+}
+
+}  // namespace
+}  // namespace test
@@ -0,0 +1,108 @@
+#include <yaclib/async/contract.hpp>
+#include <yaclib/async/make.hpp>
+#include <yaclib/async/run.hpp>
+#include <yaclib/coro/future.hpp>
+#include <yaclib/coro/on.hpp>
+#include <yaclib/coro/when_each.hpp>
+#include <yaclib/runtime/fair_thread_pool.hpp>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace test {
+namespace {
+
+TEST(EachStream, Order) {
+  std::vector<yaclib::Future<int>> futures;
+  std::vector<yaclib::Promise<int>> promises;
+  for (int i = 0; i != 3; ++i) {
+    auto [f, p] = yaclib::MakeContract<int>();
+    futures.push_back(std::move(f));
+    promises.push_back(std::move(p));
+  }
+  std::vector<std::size_t> indices;
+  auto coro = [&]() -> yaclib::Future<> {
+    auto each = yaclib::WhenEach(futures.begin(), futures.end());
+    while (auto item = co_await each.Next()) {
+      auto& [index, result] = *item;
+      EXPECT_EQ(std::move(result).Ok(), static_cast<int>(index));
+      indices.push_back(index);
+    }
+    co_return{};
+  };
+  auto f = coro();
+  std::move(promises[1]).Set(1);
+  EXPECT_EQ(indices, (std::vector<std::size_t>{1}));
+  std::move(promises[2]).Set(2);
+  EXPECT_EQ(indices, (std::vector<std::size_t>{1, 2}));
+  EXPECT_FALSE(f.Ready());
+  std::move(promises[0]).Set(0);
+  EXPECT_EQ(indices, (std::vector<std::size_t>{1, 2, 0}));
+  EXPECT_TRUE(f.Ready());
+}
+
+TEST(EachStream, Empty) {
+  std::vector<yaclib::Future<>> futures;
+  auto coro = [&]() -> yaclib::Future<> {
+    auto each = yaclib::WhenEach(futures.begin(), futures.end());
+    EXPECT_FALSE(co_await each.Next());
+    co_return{};
+  };
+  EXPECT_TRUE(coro().Ready());
+}
+
+TEST(EachStream, Break) {
+  std::vector<yaclib::Future<>> futures;
+  std::vector<yaclib::Promise<>> promises;
+  for (int i = 0; i != 3; ++i) {
+    auto [f, p] = yaclib::MakeContract();
+    futures.push_back(std::move(f));
+    promises.push_back(std::move(p));
+  }
+  auto coro = [&]() -> yaclib::Future<std::size_t> {
+    auto each = yaclib::WhenEach(futures.begin(), futures.end());
+    auto item = co_await each.Next();
+    co_return item->first;
+  };
+  auto f = coro();
+  std::move(promises[1]).Set();
+  EXPECT_EQ(std::move(f).Get().Ok(), 1);
+  // Nobody needs the rest of the results
+  EXPECT_TRUE(promises[0].StopRequested());
+  EXPECT_TRUE(promises[2].StopRequested());
+  std::move(promises[0]).Set();
+  std::move(promises[2]).Set();
+}
+
+TEST(EachStream, Stress) {
+  yaclib::FairThreadPool tp{4};
+  constexpr std::size_t kFutures = 1000;
+  std::vector<yaclib::FutureOn<std::size_t>> futures;
+  for (std::size_t i = 0; i != kFutures; ++i) {
+    futures.push_back(yaclib::Run(tp, [i] {
+      return i;
+    }));
+  }
+  auto coro = [&]() -> yaclib::Future<std::size_t> {
+    co_await On(tp);
+    auto each = yaclib::WhenEach(futures.begin(), futures.end());
+    std::size_t sum = 0;
+    std::size_t count = 0;
+    while (auto item = co_await each.Next()) {
+      EXPECT_EQ(std::move(item->second).Ok(), item->first);
+      sum += item->first;
+      ++count;
+    }
+    EXPECT_EQ(count, kFutures);
+    co_return sum;
+  };
+  EXPECT_EQ(coro().Get().Ok(), kFutures * (kFutures - 1) / 2);
+  tp.Stop();
+  tp.Wait();
+}
+
+}  // namespace
+}  // namespace test
@@ -0,0 +1,195 @@
+#include <yaclib/exe/executor.hpp>
+#include <yaclib/exe/job.hpp>
+#include <yaclib/exe/manual.hpp>
+#include <yaclib/exe/strand.hpp>
+#include <yaclib/runtime/fair_thread_pool.hpp>
+#include <yaclib/runtime/golang_thread_pool.hpp>
+#include <yaclib/runtime/lock_free_thread_pool.hpp>
+#include <yaclib/runtime/single_thread.hpp>
+#include <yaclib/util/detail/intrusive_list.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <yaclib_std/atomic>
+#include <yaclib_std/thread>
+
+#include <gtest/gtest.h>
+
+namespace test {
+namespace {
+
+struct Counters {
+  yaclib_std::atomic_size_t called{0};
+  yaclib_std::atomic_size_t dropped{0};
+  yaclib_std::atomic_size_t next{0};
+  yaclib_std::atomic_bool ordered{true};
+};
+
+class CountJob final : public yaclib::Job {
+ public:
+  void Call() noexcept final {
+    if (_counters->next.exchange(_index + 1, std::memory_order_relaxed) != _index) {
+      _counters->ordered.store(false, std::memory_order_relaxed);
+    }
+    _counters->called.fetch_add(1, std::memory_order_release);
+  }
+
+  void Drop() noexcept final {
+    _counters->dropped.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  Counters* _counters{nullptr};
+  std::size_t _index{0};
+};
+
+std::vector<CountJob> MakeBatch(Counters& counters, yaclib::detail::List& list, std::size_t count) {
+  std::vector<CountJob> jobs(count);
+  for (std::size_t i = 0; i != count; ++i) {
+    jobs[i]._counters = &counters;
+    jobs[i]._index = i;
+    list.PushBack(jobs[i]);
+  }
+  return jobs;
+}
+
+template <typename Executor>
+void CheckBatch(Executor& e, bool ordered) {
+  for (std::size_t count : {0, 1, 2, 100, 10000}) {
+    Counters counters;
+    yaclib::detail::List list;
+    auto jobs = MakeBatch(counters, list, count);
+    e.SubmitBatch(list, count);
+    EXPECT_TRUE(list.Empty());
+    while (counters.called.load(std::memory_order_acquire) != count) {
+      yaclib_std::this_thread::yield();
+    }
+    EXPECT_EQ(counters.dropped.load(), 0);
+    if (ordered) {
+      EXPECT_TRUE(counters.ordered);
+    }
+  }
+}
+
+template <typename Executor>
+void CheckStopped(Executor& e) {
+  Counters counters;
+  yaclib::detail::List list;
+  auto jobs = MakeBatch(counters, list, 100);
+  e.SubmitBatch(list, 100);
+  EXPECT_TRUE(list.Empty());
+  EXPECT_EQ(counters.called.load(), 0);
+  EXPECT_EQ(counters.dropped.load(), 100);
+}
+
+TEST(SubmitBatch, FairThreadPool) {
+  for (std::uint64_t threads : {1, 4}) {
+    yaclib::FairThreadPool tp{threads};
+    CheckBatch(tp, threads == 1);
+    tp.Stop();
+    tp.Wait();
+    CheckStopped(tp);
+  }
+}
+
+TEST(SubmitBatch, GolangThreadPool) {
+  yaclib::GolangThreadPool tp{4};
+  CheckBatch(tp, false);
+  tp.Stop();
+  tp.Wait();
+  CheckStopped(tp);
+}
+
+TEST(SubmitBatch, LockFreeThreadPool) {
+  yaclib::LockFreeThreadPool tp{1, 16};
+  CheckBatch(tp, true);
+  tp.Stop();
+  tp.Wait();
+  CheckStopped(tp);
+}
+
+TEST(SubmitBatch, SingleThread) {
+  yaclib::SingleThread e;
+  CheckBatch(e, true);
+  e.Stop();
+  e.Wait();
+  CheckStopped(e);
+}
+
+TEST(SubmitBatch, Strand) {
+  auto tp = yaclib::MakeFairThreadPool(4);
+  auto strand = yaclib::MakeStrand(tp);
+  CheckBatch(*strand, true);
+  tp->SoftStop();
+  tp->Wait();
+}
+
+TEST(SubmitBatch, StrandMixed) {
+  auto tp = yaclib::MakeFairThreadPool(4);
+  auto strand = yaclib::MakeStrand(tp);
+  Counters counters;
+  constexpr std::size_t kBatches = 100;
+  constexpr std::size_t kBatch = 10;
+  std::vector<CountJob> jobs(kBatches * kBatch);
+  for (std::size_t b = 0; b != kBatches; ++b) {
+    yaclib::detail::List list;
+    for (std::size_t i = b * kBatch; i != (b + 1) * kBatch; ++i) {
+      jobs[i]._counters = &counters;
+      jobs[i]._index = i;
+      if (i % 2 == 0) {
+        list.PushBack(jobs[i]);
+      } else {
+        strand->SubmitBatch(list, 1);
+        strand->Submit(jobs[i]);
+      }
+    }
+  }
+  tp->SoftStop();
+  tp->Wait();
+  EXPECT_EQ(counters.called.load(), kBatches * kBatch);
+  EXPECT_TRUE(counters.ordered);
+}
+
+TEST(SubmitBatch, Manual) {
+  yaclib::ManualExecutor e;
+  Counters counters;
+  yaclib::detail::List list;
+  auto jobs = MakeBatch(counters, list, 100);
+  e.SubmitBatch(list, 100);
+  EXPECT_TRUE(list.Empty());
+  EXPECT_EQ(counters.called.load(), 0);
+  EXPECT_EQ(e.Drain(), 100);
+  EXPECT_TRUE(counters.ordered);
+}
+
+TEST(SubmitBatch, Default) {
+  class Counting final : public yaclib::IExecutor {
+   public:
+    [[nodiscard]] Type Tag() const noexcept final {
+      return Type::Custom;
+    }
+
+    [[nodiscard]] bool Alive() const noexcept final {
+      return true;
+    }
+
+    void Submit(yaclib::Job& job) noexcept final {
+      ++submits;
+      job.Call();
+    }
+
+    std::size_t submits{0};
+  };
+  Counting e;
+  Counters counters;
+  yaclib::detail::List list;
+  auto jobs = MakeBatch(counters, list, 100);
+  static_cast<yaclib::IExecutor&>(e).SubmitBatch(list, 100);
+  EXPECT_TRUE(list.Empty());
+  EXPECT_EQ(e.submits, 100);
+  EXPECT_EQ(counters.called.load(), 100);
+  EXPECT_TRUE(counters.ordered);
+}
+
+}  // namespace
+}  // namespace test
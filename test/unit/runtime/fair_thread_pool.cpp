@@ -7,12 +7,18 @@
 #include <yaclib/exe/submit.hpp>
 #include <yaclib/runtime/fair_thread_pool.hpp>
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <stdexcept>
+#include <string>
 #include <thread>
 #include <vector>
 #include <yaclib_std/atomic>
 #include <yaclib_std/chrono>
+#include <yaclib_std/thread>
 
 #include <gtest/gtest.h>
 
@@ -451,6 +457,53 @@ TEST(InlineDrop, Alive) {
   EXPECT_FALSE(inline_drop.Alive());
 }
 
+TEST(FairThreadPool, SpinBudget) {
+  for (std::uint32_t budget : {0U, 1U, yaclib::FairThreadPool::kSpinBudget, 1U << 20U}) {
+    yaclib::FairThreadPool tp{4, budget};
+    yaclib_std::atomic_size_t counter{0};
+    constexpr std::size_t kBursts = 100;
+    constexpr std::size_t kBurst = 64;
+    for (std::size_t i = 0; i != kBursts; ++i) {
+      for (std::size_t j = 0; j != kBurst; ++j) {
+        Submit(tp, [&] {
+          counter.fetch_add(1, std::memory_order_relaxed);
+        });
+      }
+      while (counter.load() != (i + 1) * kBurst) {
+        yaclib_std::this_thread::yield();
+      }
+      if (i % 10 == 0) {
+        // Let workers park
+        yaclib_std::this_thread::sleep_for(1ms);
+      }
+    }
+    tp.SoftStop();
+    tp.Wait();
+    EXPECT_EQ(counter.load(), kBursts * kBurst);
+  }
+}
+
+TEST(FairThreadPool, WakeFromJob) {
+  // Only one worker is woken by Submit, it should wake up the next one when it takes the job
+  yaclib::FairThreadPool tp{4, 0};
+  yaclib_std::atomic_size_t started{0};
+  yaclib_std::atomic_bool check{false};
+  for (std::size_t i = 0; i != 4; ++i) {
+    Submit(tp, [&] {
+      started.fetch_add(1);
+      while (!check.load()) {
+        yaclib_std::this_thread::yield();
+      }
+    });
+  }
+  while (started.load() != 4) {
+    yaclib_std::this_thread::yield();
+  }
+  check.store(true);
+  tp.SoftStop();
+  tp.Wait();
+}
+
 // TODO(Ri7ay) Don't work on windows, check this:
 //  https://stackoverflow.com/questions/12606033/computing-cpu-time-in-c-on-windows
 #if YACLIB_CI_SLOWDOWN == 1 && (defined(GTEST_OS_LINUX) || defined(GTEST_OS_MAC))
@@ -485,5 +538,68 @@ TEST(FairThreadPool, NotBurnCPU) {
 
 #endif
 
+#if defined(GTEST_OS_LINUX) && defined(RUSAGE_THREAD)
+std::size_t WorkerSwitches(std::uint32_t spin_budget) {
+  // Only the workers are measured, every job updates the counter of the thread which runs it
+  struct Switches {
+    std::size_t first = 0;
+    std::size_t last = 0;
+  };
+  constexpr std::uint32_t kThreads = 4;
+  constexpr std::size_t kBursts = 200;
+  constexpr std::size_t kBurst = 64;
+  yaclib::FairThreadPool tp{kThreads, spin_budget};
+  yaclib_std::atomic_size_t counter{0};
+  yaclib_std::atomic_size_t workers{0};
+  std::array<Switches, kThreads> switches{};
+  for (std::size_t i = 0; i != kBursts; ++i) {
+    for (std::size_t j = 0; j != kBurst; ++j) {
+      Submit(tp, [&] {
+        thread_local Switches* self = nullptr;
+        const auto now = test::util::ThreadVoluntaryContextSwitches();
+        if (self == nullptr) {
+          self = &switches[workers.fetch_add(1, std::memory_order_relaxed)];
+          self->first = now;
+        }
+        self->last = now;
+        counter.fetch_add(1, std::memory_order_relaxed);
+      });
+    }
+    while (counter.load() != (i + 1) * kBurst) {
+      yaclib_std::this_thread::yield();
+    }
+  }
+  tp.SoftStop();
+  tp.Wait();
+  EXPECT_EQ(counter.load(), kBursts * kBurst);
+  EXPECT_LE(workers.load(), kThreads);
+  std::size_t total = 0;
+  for (const auto& worker : switches) {
+    total += worker.last - worker.first;
+  }
+  return total;
+}
+
+TEST(FairThreadPool, SwitchesPerJob) {
+  // Spinning is disabled on the single core, so both runs are the same and only the noise is compared
+  if (yaclib_std::thread::hardware_concurrency() == 1) {
+    GTEST_SKIP();
+  }
+  // There is no absolute bound: if jobs are faster than Submit, a worker can park once per job on the loaded machine.
+  // But spinning workers can't park more often than the workers which park immediately.
+  // Both runs do the same jobs, the best of few runs and the slack, 10% and a switch per burst, are for the noise.
+  constexpr int kRuns = 3;
+  std::size_t parking = std::numeric_limits<std::size_t>::max();
+  std::size_t spinning = std::numeric_limits<std::size_t>::max();
+  for (int i = 0; i != kRuns; ++i) {
+    parking = std::min(parking, WorkerSwitches(0));
+    spinning = std::min(spinning, WorkerSwitches(yaclib::FairThreadPool::kSpinBudget));
+  }
+  RecordProperty("switches_without_spinning", std::to_string(parking));
+  RecordProperty("switches_with_spinning", std::to_string(spinning));
+  EXPECT_LE(spinning, parking + parking / 10 + 200);
+}
+#endif
+
 }  // namespace
 }  // namespace test
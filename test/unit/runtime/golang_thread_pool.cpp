@@ -0,0 +1,291 @@
+#include <util/time.hpp>
+
+#include <yaclib/async/run.hpp>
+#include <yaclib/async/wait.hpp>
+#include <yaclib/exe/executor.hpp>
+#include <yaclib/exe/submit.hpp>
+#include <yaclib/runtime/golang_thread_pool.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+#include <yaclib_std/atomic>
+#include <yaclib_std/chrono>
+#include <yaclib_std/thread>
+
+#include <gtest/gtest.h>
+
+namespace test {
+namespace {
+
+using namespace std::chrono_literals;
+
+const auto kCoresCount = std::max(yaclib_std::thread::hardware_concurrency(), 2U);
+
+enum class StopType {
+  SoftStop = 0,
+  Stop,
+  HardStop,
+};
+
+void Join(yaclib::GolangThreadPool& tp, StopType stop_type) {
+  switch (stop_type) {
+    case StopType::SoftStop:
+      tp.SoftStop();
+      break;
+    case StopType::Stop:
+      tp.Stop();
+      break;
+    case StopType::HardStop:
+      tp.HardStop();
+      break;
+  }
+  tp.Wait();
+}
+
+TEST(GolangThreadPool, JustWork) {
+  auto tp = yaclib::MakeGolangThreadPool(kCoresCount);
+  EXPECT_EQ(tp->Tag(), yaclib::IExecutor::Type::GolangThreadPool);
+  EXPECT_TRUE(tp->Alive());
+  bool ready = false;
+  Submit(*tp, [&] {
+    ready = true;
+  });
+
+  tp->Stop();
+  tp->Wait();
+
+  EXPECT_FALSE(tp->Alive());
+  EXPECT_TRUE(ready);
+}
+
+TEST(GolangThreadPool, ExecuteFrom) {
+  for (auto cores : {1U, kCoresCount}) {
+    yaclib::GolangThreadPool tp{cores};
+    bool done{false};
+    Submit(tp, [&] {
+      Submit(tp, [&] {
+        done = true;
+      });
+    });
+
+    tp.SoftStop();
+    tp.Wait();
+
+    EXPECT_TRUE(done);
+  }
+}
+
+TEST(GolangThreadPool, AfterStop) {
+  for (auto stop_type : {StopType::SoftStop, StopType::Stop, StopType::HardStop}) {
+    for (auto cores : {1U, kCoresCount}) {
+      yaclib::GolangThreadPool tp{cores};
+      yaclib_std::atomic_bool ready{false};
+      if (stop_type != StopType::HardStop) {
+        Submit(tp, [&] {
+          ready = true;
+        });
+      }
+      Join(tp, stop_type);
+      EXPECT_EQ(ready.load(), stop_type != StopType::HardStop);
+      Submit(tp, [] {
+        FAIL();
+      });
+      tp.Wait();
+    }
+  }
+}
+
+TEST(GolangThreadPool, HardStopDropsLocal) {
+  yaclib::GolangThreadPool tp{1};
+  yaclib_std::atomic_bool started{false};
+  yaclib_std::atomic_bool stopped{false};
+  yaclib_std::atomic_size_t called{0};
+  Submit(tp, [&] {
+    for (std::size_t i = 0; i != 1000; ++i) {
+      Submit(tp, [&] {
+        called.fetch_add(1, std::memory_order_relaxed);
+      });
+    }
+    started = true;
+    while (!stopped) {
+      yaclib_std::this_thread::yield();
+    }
+  });
+  while (!started) {
+    yaclib_std::this_thread::yield();
+  }
+  tp.HardStop();
+  stopped = true;
+  tp.Wait();
+  EXPECT_EQ(called.load(), 0);
+}
+
+TEST(GolangThreadPool, Exception) {
+  for (auto stop_type : {StopType::SoftStop, StopType::Stop}) {
+    for (auto cores : {1U, kCoresCount}) {
+      yaclib::GolangThreadPool tp{cores};
+      int flag = 0;
+      yaclib_std::atomic_bool check{false};
+      Submit(tp, [&] {
+        flag += 1;
+        while (stop_type == StopType::Stop && !check.load()) {
+        }
+        Submit(tp, [&] {
+          flag += 2;
+        });
+        throw std::runtime_error{"task failed"};
+      });
+      if (stop_type == StopType::SoftStop) {
+        tp.SoftStop();
+      } else {
+        tp.Stop();
+        check.store(true);
+      }
+      tp.Wait();
+      EXPECT_EQ(flag, stop_type == StopType::SoftStop ? 3 : 1);
+    }
+  }
+}
+
+TEST(GolangThreadPool, ManyTask) {
+  for (auto stop_type : {StopType::SoftStop, StopType::Stop}) {
+    for (auto cores : {1U, kCoresCount}) {
+      yaclib::GolangThreadPool tp{cores};
+      const std::size_t tasks{1024 * cores};
+      yaclib_std::atomic_size_t completed{0};
+      for (std::size_t i = 0; i != tasks; ++i) {
+        Submit(tp, [&completed] {
+          completed.fetch_add(1, std::memory_order_relaxed);
+        });
+      }
+      Join(tp, stop_type);
+      EXPECT_EQ(completed, tasks);
+    }
+  }
+}
+
+TEST(GolangThreadPool, ManyTaskFromWorker) {
+  // More than local queue capacity, so it overflows to the global queue
+  for (auto cores : {1U, kCoresCount}) {
+    yaclib::GolangThreadPool tp{cores};
+    constexpr std::size_t kTasks = 10000;
+    yaclib_std::atomic_size_t completed{0};
+    Submit(tp, [&] {
+      for (std::size_t i = 0; i != kTasks; ++i) {
+        Submit(tp, [&completed] {
+          completed.fetch_add(1, std::memory_order_relaxed);
+        });
+      }
+    });
+    Join(tp, StopType::SoftStop);
+    EXPECT_EQ(completed, kTasks);
+  }
+}
+
+void Spawn(yaclib::GolangThreadPool& tp, yaclib_std::atomic_size_t& completed, std::size_t depth) {
+  completed.fetch_add(1, std::memory_order_relaxed);
+  if (depth == 0) {
+    return;
+  }
+  Submit(tp, [&tp, &completed, depth] {
+    Spawn(tp, completed, depth - 1);
+  });
+  Submit(tp, [&tp, &completed, depth] {
+    Spawn(tp, completed, depth - 1);
+  });
+}
+
+TEST(GolangThreadPool, Tree) {
+  for (auto cores : {1U, kCoresCount}) {
+    yaclib::GolangThreadPool tp{cores};
+    constexpr std::size_t kDepth = 14;
+    yaclib_std::atomic_size_t completed{0};
+    Submit(tp, [&] {
+      Spawn(tp, completed, kDepth);
+    });
+    Join(tp, StopType::SoftStop);
+    EXPECT_EQ(completed, (std::size_t{1} << (kDepth + 1)) - 1);
+  }
+}
+
+TEST(GolangThreadPool, NextNotStarve) {
+  // Two jobs which submit each other shouldn't starve other jobs in the local queue
+  yaclib::GolangThreadPool tp{1};
+  yaclib_std::atomic_bool done{false};
+  yaclib_std::atomic_size_t ping_pong{0};
+  std::function<void()> ping = [&] {
+    ping_pong.fetch_add(1, std::memory_order_relaxed);
+    if (!done.load(std::memory_order_relaxed)) {
+      Submit(tp, ping);
+    }
+  };
+  Submit(tp, [&] {
+    Submit(tp, [&] {
+      done = true;
+    });
+    Submit(tp, ping);
+  });
+  Join(tp, StopType::SoftStop);
+  EXPECT_TRUE(done.load());
+  EXPECT_GE(ping_pong.load(), 1);
+}
+
+TEST(GolangThreadPool, StealFromBusy) {
+  // Job submitted to the "next" slot of the blocked worker should be stolen
+  yaclib::GolangThreadPool tp{2};
+  yaclib_std::atomic_bool done{false};
+  Submit(tp, [&] {
+    Submit(tp, [&] {
+      done = true;
+    });
+    while (!done.load()) {
+      yaclib_std::this_thread::yield();
+    }
+  });
+  Join(tp, StopType::SoftStop);
+  EXPECT_TRUE(done.load());
+}
+
+TEST(GolangThreadPool, UseAllThreads) {
+  yaclib::GolangThreadPool tp{2};
+  yaclib_std::atomic_size_t counter{0};
+  auto sleeper = [&counter] {
+    yaclib_std::this_thread::sleep_for(50ms * YACLIB_CI_SLOWDOWN);
+    counter.fetch_add(1, std::memory_order_relaxed);
+  };
+  test::util::StopWatch stop_watch;
+  Submit(tp, sleeper);
+  Submit(tp, sleeper);
+  Join(tp, StopType::SoftStop);
+  EXPECT_EQ(counter, 2);
+  EXPECT_LT(stop_watch.Elapsed(), 100ms * YACLIB_CI_SLOWDOWN);
+}
+
+TEST(GolangThreadPool, Future) {
+  auto tp = yaclib::MakeGolangThreadPool(kCoresCount);
+  constexpr int kChains = 100;
+  std::vector<yaclib::FutureOn<int>> futures;
+  futures.reserve(kChains);
+  for (int i = 0; i != kChains; ++i) {
+    auto future = yaclib::Run(*tp, [i] {
+      return i;
+    });
+    for (int j = 0; j != 10; ++j) {
+      future = std::move(future).Then([](int x) {
+        return x + 1;
+      });
+    }
+    futures.push_back(std::move(future));
+  }
+  yaclib::Wait(futures.begin(), futures.end());
+  for (int i = 0; i != kChains; ++i) {
+    EXPECT_EQ(std::move(futures[i]).Get().Ok(), i + 10);
+  }
+  tp->SoftStop();
+  tp->Wait();
+}
+
+}  // namespace
+}  // namespace test
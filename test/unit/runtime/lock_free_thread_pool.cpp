@@ -0,0 +1,238 @@
+#include <yaclib/async/run.hpp>
+#include <yaclib/exe/executor.hpp>
+#include <yaclib/exe/submit.hpp>
+#include <yaclib/runtime/fair_thread_pool.hpp>
+#include <yaclib/runtime/lock_free_thread_pool.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <yaclib_std/atomic>
+#include <yaclib_std/thread>
+
+#include <gtest/gtest.h>
+
+namespace test {
+namespace {
+
+TEST(LockFreeThreadPool, JustWork) {
+  auto tp = yaclib::MakeLockFreeThreadPool(2);
+  EXPECT_EQ(tp->Tag(), yaclib::IExecutor::Type::LockFreeThreadPool);
+  EXPECT_TRUE(tp->Alive());
+  bool ready = false;
+  Submit(*tp, [&] {
+    ready = true;
+  });
+  tp->Stop();
+  tp->Wait();
+  EXPECT_FALSE(tp->Alive());
+  EXPECT_TRUE(ready);
+  Submit(*tp, [] {
+    FAIL();
+  });
+}
+
+TEST(LockFreeThreadPool, SingleThreadFIFO) {
+  // Small capacity to check order with the overflow list
+  for (std::size_t capacity : {2, 16, 4096}) {
+    yaclib::LockFreeThreadPool tp{1, capacity};
+    std::size_t next_task{0};
+    constexpr std::size_t kTasks{1024};
+    for (std::size_t i = 0; i != kTasks; ++i) {
+      Submit(tp, [i, &next_task] {
+        EXPECT_EQ(next_task, i);
+        ++next_task;
+      });
+    }
+    tp.SoftStop();
+    tp.Wait();
+    EXPECT_EQ(next_task, kTasks);
+  }
+}
+
+TEST(LockFreeThreadPool, Exception) {
+  yaclib::LockFreeThreadPool tp{2};
+  int flag = 0;
+  yaclib_std::atomic_bool check{false};
+  Submit(tp, [&] {
+    flag += 1;
+    while (!check.load()) {
+    }
+    Submit(tp, [&] {
+      flag += 2;
+    });
+    throw std::runtime_error{"task failed"};
+  });
+  tp.Stop();
+  check.store(true);
+  tp.Wait();
+  EXPECT_EQ(flag, 1);
+}
+
+TEST(LockFreeThreadPool, HardStop) {
+  yaclib::LockFreeThreadPool tp{1};
+  yaclib_std::atomic_bool started{false};
+  yaclib_std::atomic_bool check{false};
+  std::size_t counter = 0;
+  Submit(tp, [&] {
+    started = true;
+    while (!check.load()) {
+    }
+  });
+  while (!started.load()) {
+    yaclib_std::this_thread::yield();
+  }
+  for (std::size_t i = 0; i != 100; ++i) {
+    Submit(tp, [&] {
+      ++counter;
+    });
+  }
+  tp.HardStop();
+  check.store(true);
+  tp.Wait();
+  EXPECT_EQ(counter, 0);
+}
+
+TEST(LockFreeThreadPool, ExecuteFrom) {
+  yaclib::LockFreeThreadPool tp{2};
+  yaclib_std::atomic_size_t counter{0};
+  Submit(tp, [&] {
+    for (std::size_t i = 0; i != 100; ++i) {
+      Submit(tp, [&] {
+        counter.fetch_add(1, std::memory_order_relaxed);
+      });
+    }
+  });
+  tp.SoftStop();
+  tp.Wait();
+  EXPECT_EQ(counter.load(), 100);
+}
+
+TEST(LockFreeThreadPool, WakeFromJob) {
+  // Only one worker is woken by Submit, it should wake up the next one when it takes the job
+  for (std::uint32_t budget : {0U, yaclib::LockFreeThreadPool::kSpinBudget}) {
+    yaclib::LockFreeThreadPool tp{4, 4096, budget};
+    yaclib_std::atomic_size_t started{0};
+    yaclib_std::atomic_bool check{false};
+    for (std::size_t i = 0; i != 4; ++i) {
+      Submit(tp, [&] {
+        started.fetch_add(1);
+        while (!check.load()) {
+          yaclib_std::this_thread::yield();
+        }
+      });
+    }
+    while (started.load() != 4) {
+      yaclib_std::this_thread::yield();
+    }
+    check.store(true);
+    tp.SoftStop();
+    tp.Wait();
+  }
+}
+
+template <typename ThreadPool>
+class ThreadPoolProducers : public testing::Test {};
+
+using ThreadPools = testing::Types<yaclib::FairThreadPool, yaclib::LockFreeThreadPool>;
+
+class ThreadPoolNames {
+ public:
+  template <typename T>
+  static std::string GetName(int /*i*/) {
+    return std::is_same_v<T, yaclib::FairThreadPool> ? "Fair" : "LockFree";
+  }
+};
+
+TYPED_TEST_SUITE(ThreadPoolProducers, ThreadPools, ThreadPoolNames);
+
+TYPED_TEST(ThreadPoolProducers, Throughput) {
+  // Same workload for both pools, benchmarks are in the YACLib/Bench repo
+  for (std::size_t producers : {1, 4, 16, 64}) {
+    TypeParam tp{4};
+    const std::size_t tasks = 64 * 1024 / producers;
+    yaclib_std::atomic_size_t completed{0};
+    std::vector<yaclib_std::thread> threads;
+    threads.reserve(producers);
+    for (std::size_t p = 0; p != producers; ++p) {
+      threads.emplace_back([&] {
+        for (std::size_t i = 0; i != tasks; ++i) {
+          Submit(tp, [&] {
+            completed.fetch_add(1, std::memory_order_relaxed);
+          });
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    tp.SoftStop();
+    tp.Wait();
+    EXPECT_EQ(completed.load(), producers * tasks);
+  }
+}
+
+TYPED_TEST(ThreadPoolProducers, ProducerOrder) {
+  // With one worker jobs of every producer are called in the submission order
+  for (std::size_t producers : {1, 4, 16, 64}) {
+    TypeParam tp{1};
+    constexpr std::size_t kTasks = 256;
+    std::vector<std::size_t> last(producers, 0);
+    std::vector<yaclib_std::thread> threads;
+    threads.reserve(producers);
+    for (std::size_t p = 0; p != producers; ++p) {
+      threads.emplace_back([&, p] {
+        for (std::size_t i = 1; i <= kTasks; ++i) {
+          Submit(tp, [&, p, i] {
+            EXPECT_EQ(last[p] + 1, i);
+            last[p] = i;
+          });
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    tp.SoftStop();
+    tp.Wait();
+    for (auto count : last) {
+      EXPECT_EQ(count, kTasks);
+    }
+  }
+}
+
+TYPED_TEST(ThreadPoolProducers, StopWhileSubmit) {
+  for (std::size_t producers : {1, 4}) {
+    TypeParam tp{2};
+    yaclib_std::atomic_size_t called{0};
+    yaclib_std::atomic_size_t dropped{0};
+    std::vector<yaclib_std::thread> threads;
+    constexpr std::size_t kTasks = 10000;
+    for (std::size_t p = 0; p != producers; ++p) {
+      threads.emplace_back([&] {
+        for (std::size_t i = 0; i != kTasks; ++i) {
+          auto f = yaclib::Run(tp, [&] {
+            called.fetch_add(1, std::memory_order_relaxed);
+          });
+          std::move(f).DetachInline([&](yaclib::Result<>&& r) {
+            if (r.State() != yaclib::ResultState::Value) {
+              dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+          });
+        }
+      });
+    }
+    tp.Stop();
+    tp.Wait();
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    EXPECT_EQ(called.load() + dropped.load(), producers * kTasks);
+  }
+}
+
+}  // namespace
+}  // namespace test
@@ -0,0 +1,191 @@
+#include <yaclib/async/run.hpp>
+#include <yaclib/async/wait.hpp>
+#include <yaclib/exe/executor.hpp>
+#include <yaclib/exe/submit.hpp>
+#include <yaclib/runtime/single_thread.hpp>
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+#include <yaclib_std/atomic>
+#include <yaclib_std/chrono>
+#include <yaclib_std/thread>
+
+#include <gtest/gtest.h>
+
+namespace test {
+namespace {
+
+using namespace std::chrono_literals;
+
+TEST(SingleThread, JustWork) {
+  auto e = yaclib::MakeSingleThread();
+  EXPECT_EQ(e->Tag(), yaclib::IExecutor::Type::SingleThread);
+  EXPECT_TRUE(e->Alive());
+  bool ready = false;
+  Submit(*e, [&] {
+    ready = true;
+  });
+  e->Stop();
+  e->Wait();
+  EXPECT_FALSE(e->Alive());
+  EXPECT_TRUE(ready);
+}
+
+TEST(SingleThread, FIFO) {
+  yaclib::SingleThread e;
+  std::size_t next_task{0};
+  constexpr std::size_t kTasks{1024};
+  for (std::size_t i = 0; i != kTasks; ++i) {
+    Submit(e, [i, &next_task] {
+      EXPECT_EQ(next_task, i);
+      ++next_task;
+    });
+  }
+  e.SoftStop();
+  e.Wait();
+  EXPECT_EQ(next_task, kTasks);
+}
+
+TEST(SingleThread, SameThread) {
+  yaclib::SingleThread e;
+  std::thread::id id;
+  Submit(e, [&] {
+    id = std::this_thread::get_id();
+  });
+  for (std::size_t i = 0; i != 100; ++i) {
+    Submit(e, [&] {
+      EXPECT_EQ(id, std::this_thread::get_id());
+    });
+  }
+  e.SoftStop();
+  e.Wait();
+  EXPECT_NE(id, std::this_thread::get_id());
+}
+
+TEST(SingleThread, ExecuteFrom) {
+  yaclib::SingleThread e;
+  std::size_t counter{0};
+  Submit(e, [&] {
+    Submit(e, [&] {
+      ++counter;
+      Submit(e, [&] {
+        ++counter;
+      });
+    });
+  });
+  e.SoftStop();
+  e.Wait();
+  EXPECT_EQ(counter, 2);
+}
+
+TEST(SingleThread, Stop) {
+  yaclib::SingleThread e;
+  int flag = 0;
+  yaclib_std::atomic_bool check{false};
+  Submit(e, [&] {
+    flag += 1;
+    while (!check.load()) {
+    }
+    Submit(e, [&] {
+      flag += 2;
+    });
+  });
+  e.Stop();
+  check.store(true);
+  e.Wait();
+  EXPECT_EQ(flag, 1);
+  Submit(e, [] {
+    FAIL();
+  });
+  e.Wait();
+}
+
+TEST(SingleThread, HardStop) {
+  yaclib::SingleThread e;
+  yaclib_std::atomic_bool started{false};
+  yaclib_std::atomic_bool check{false};
+  std::size_t counter = 0;
+  Submit(e, [&] {
+    started = true;
+    while (!check.load()) {
+    }
+  });
+  while (!started.load()) {
+    yaclib_std::this_thread::yield();
+  }
+  for (std::size_t i = 0; i != 100; ++i) {
+    Submit(e, [&] {
+      ++counter;
+    });
+  }
+  e.HardStop();
+  check.store(true);
+  e.Wait();
+  EXPECT_EQ(counter, 0);
+}
+
+TEST(SingleThread, SoftStopIdle) {
+  for (auto sleep : {0ms, 10ms}) {
+    yaclib::SingleThread e;
+    yaclib_std::this_thread::sleep_for(sleep);
+    e.SoftStop();
+    e.Wait();
+    EXPECT_FALSE(e.Alive());
+  }
+}
+
+TEST(SingleThread, ParkAndWake) {
+  yaclib::SingleThread e;
+  yaclib_std::atomic_size_t counter{0};
+  for (std::size_t i = 0; i != 10; ++i) {
+    Submit(e, [&] {
+      counter.fetch_add(1, std::memory_order_relaxed);
+    });
+    yaclib_std::this_thread::sleep_for(1ms);
+  }
+  e.SoftStop();
+  e.Wait();
+  EXPECT_EQ(counter.load(), 10);
+}
+
+TEST(SingleThread, ManyProducers) {
+  yaclib::SingleThread e;
+  constexpr std::size_t kProducers = 4;
+  constexpr std::size_t kTasks = 10000;
+  std::size_t last[kProducers] = {};
+  std::size_t counter = 0;
+  std::vector<yaclib_std::thread> producers;
+  for (std::size_t p = 0; p != kProducers; ++p) {
+    producers.emplace_back([&, p] {
+      for (std::size_t i = 1; i <= kTasks; ++i) {
+        Submit(e, [&, p, i] {
+          EXPECT_EQ(last[p] + 1, i);
+          last[p] = i;
+          ++counter;
+        });
+      }
+    });
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  e.SoftStop();
+  e.Wait();
+  EXPECT_EQ(counter, kProducers * kTasks);
+}
+
+TEST(SingleThread, Future) {
+  auto e = yaclib::MakeSingleThread();
+  auto future = yaclib::Run(*e, [] {
+                  return 1;
+                }).Then([](int x) {
+    return x + 1;
+  });
+  EXPECT_EQ(std::move(future).Get().Ok(), 2);
+  e->Stop();
+  e->Wait();
+}
+
+}  // namespace
+}  // namespace test
@@ -0,0 +1,257 @@
+#include <yaclib/async/run.hpp>
+#include <yaclib/async/wait.hpp>
+#include <yaclib/exe/executor.hpp>
+#include <yaclib/exe/job.hpp>
+#include <yaclib/runtime/fair_thread_pool.hpp>
+#include <yaclib/runtime/timer_service.hpp>
+#include <yaclib/util/detail/intrusive_list.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <random>
+#include <vector>
+#include <yaclib_std/atomic>
+#include <yaclib_std/mutex>
+#include <yaclib_std/thread>
+
+#include <gtest/gtest.h>
+
+namespace test {
+namespace {
+
+using namespace std::chrono_literals;
+using Clock = yaclib::TimerService::Clock;
+
+class TimeJob final : public yaclib::Job {
+ public:
+  void Call() noexcept final {
+    fired = Clock::now();
+    called.store(true, std::memory_order_release);
+  }
+
+  void Drop() noexcept final {
+    dropped.store(true, std::memory_order_release);
+  }
+
+  yaclib::TimerNode node;
+  Clock::time_point deadline;
+  Clock::time_point fired;
+  yaclib_std::atomic_bool called{false};
+  yaclib_std::atomic_bool dropped{false};
+};
+
+// Timer thread submits jobs concurrently with Drain, so ManualExecutor isn't enough
+class QueueExecutor final : public yaclib::IExecutor {
+ public:
+  [[nodiscard]] Type Tag() const noexcept final {
+    return Type::Custom;
+  }
+
+  [[nodiscard]] bool Alive() const noexcept final {
+    return true;
+  }
+
+  void Submit(yaclib::Job& job) noexcept final {
+    std::lock_guard lock{_m};
+    _jobs.PushBack(job);
+    ++submitted;
+  }
+
+  void SubmitBatch(yaclib::detail::List& jobs, std::size_t count) noexcept final {
+    std::lock_guard lock{_m};
+    _jobs.PushBack(std::move(jobs));
+    ++batches;
+    submitted += count;
+  }
+
+  std::size_t Drain() noexcept {
+    yaclib::detail::List jobs;
+    {
+      std::lock_guard lock{_m};
+      jobs.PushBack(std::move(_jobs));
+    }
+    std::size_t done = 0;
+    while (!jobs.Empty()) {
+      ++done;
+      static_cast<yaclib::Job&>(jobs.PopFront()).Call();
+    }
+    return done;
+  }
+
+  std::size_t batches{0};
+  std::size_t submitted{0};
+
+ private:
+  yaclib_std::mutex _m;
+  yaclib::detail::List _jobs;
+};
+
+TEST(TimerService, ScheduleAfter) {
+  auto timer = yaclib::MakeTimerService();
+  const auto start = Clock::now();
+  auto f = timer->ScheduleAfter(10ms);
+  EXPECT_TRUE(std::move(f).Get().Ok() == yaclib::Unit{});
+  EXPECT_GE(Clock::now() - start, 10ms);
+  timer->Stop();
+  timer->Wait();
+}
+
+TEST(TimerService, ScheduleOnExecutor) {
+  yaclib::TimerService timer;
+  yaclib::FairThreadPool tp{1};
+  yaclib_std::thread::id pool_id;
+  yaclib_std::thread::id id;
+  yaclib_std::thread::id then_id;
+  auto pool = yaclib::Run(tp, [&] {
+    pool_id = yaclib_std::this_thread::get_id();
+  });
+  auto f = timer.ScheduleAt(tp, Clock::now() + 1ms).ThenInline([&] {
+    id = yaclib_std::this_thread::get_id();
+  });
+  auto g = timer.ScheduleAfter(tp, 2ms).Then([&] {
+    then_id = yaclib_std::this_thread::get_id();
+  });
+  yaclib::Wait(pool, f, g);
+  EXPECT_EQ(id, pool_id);
+  EXPECT_EQ(then_id, pool_id);
+  timer.Stop();
+  timer.Wait();
+  tp.Stop();
+  tp.Wait();
+}
+
+TEST(TimerService, Past) {
+  yaclib::TimerService timer;
+  auto f = timer.ScheduleAt(Clock::now() - 1h);
+  EXPECT_TRUE(std::move(f).Get().Ok() == yaclib::Unit{});
+  timer.Stop();
+  timer.Wait();
+}
+
+TEST(TimerService, Order) {
+  yaclib::TimerService timer{100us};
+  QueueExecutor manual;
+  constexpr std::size_t kTimers = 500;
+  std::vector<TimeJob> jobs(kTimers);
+  std::mt19937 gen{42};
+  std::uniform_int_distribution<int> dist{0, 50000};
+  const auto start = Clock::now();
+  for (auto& job : jobs) {
+    job.deadline = start + std::chrono::microseconds{dist(gen)};
+    timer.Arm(job.node, job, manual, job.deadline);
+  }
+  std::size_t done = 0;
+  while (done != kTimers) {
+    done += manual.Drain();
+  }
+  for (auto& job : jobs) {
+    EXPECT_TRUE(job.called.load());
+    EXPECT_GE(job.fired, job.deadline);
+  }
+  EXPECT_EQ(manual.submitted, kTimers);
+  // Timers which expired together are submitted by the one SubmitBatch call
+  EXPECT_LT(manual.batches, kTimers);
+  timer.Stop();
+  timer.Wait();
+}
+
+TEST(TimerService, FarAndNear) {
+  // Near timer should not wait for the far one, and far one should be cascaded to the lower levels
+  yaclib::TimerService timer;
+  QueueExecutor manual;
+  TimeJob far;
+  TimeJob near;
+  timer.Arm(far.node, far, manual, Clock::now() + 300ms);
+  timer.Arm(near.node, near, manual, Clock::now() + 5ms);
+  while (manual.Drain() == 0) {
+    yaclib_std::this_thread::yield();
+  }
+  EXPECT_TRUE(near.called.load());
+  EXPECT_FALSE(far.called.load());
+  while (manual.Drain() == 0) {
+    yaclib_std::this_thread::yield();
+  }
+  EXPECT_TRUE(far.called.load());
+  timer.Stop();
+  timer.Wait();
+}
+
+TEST(TimerService, Cancel) {
+  yaclib::TimerService timer;
+  QueueExecutor manual;
+  std::vector<TimeJob> jobs(100);
+  for (std::size_t i = 0; i != jobs.size(); ++i) {
+    timer.Arm(jobs[i].node, jobs[i], manual, Clock::now() + std::chrono::milliseconds{i % 2 == 0 ? 1 : 10000});
+  }
+  for (std::size_t i = 1; i < jobs.size(); i += 2) {
+    EXPECT_TRUE(timer.Cancel(jobs[i].node));
+    EXPECT_FALSE(timer.Cancel(jobs[i].node));
+  }
+  std::size_t done = 0;
+  while (done != jobs.size() / 2) {
+    done += manual.Drain();
+  }
+  for (std::size_t i = 0; i != jobs.size(); ++i) {
+    EXPECT_EQ(jobs[i].called.load(), i % 2 == 0);
+    EXPECT_FALSE(jobs[i].dropped.load());
+  }
+  EXPECT_FALSE(timer.Cancel(jobs[0].node));
+  // Node can be armed again
+  timer.Arm(jobs[1].node, jobs[1], manual, Clock::now());
+  while (manual.Drain() == 0) {
+    yaclib_std::this_thread::yield();
+  }
+  EXPECT_TRUE(jobs[1].called.load());
+  timer.Stop();
+  timer.Wait();
+}
+
+TEST(TimerService, Stop) {
+  yaclib::TimerService timer;
+  auto f = timer.ScheduleAfter(1h);
+  TimeJob job;
+  timer.Arm(job.node, job, yaclib::MakeInline(), Clock::now() + 1h);
+  timer.Stop();
+  timer.Wait();
+  EXPECT_EQ(std::move(f).Get().State(), yaclib::ResultState::Error);
+  EXPECT_TRUE(job.dropped.load());
+  EXPECT_FALSE(job.called.load());
+  auto g = timer.ScheduleAfter(1ms);
+  EXPECT_EQ(std::move(g).Get().State(), yaclib::ResultState::Error);
+}
+
+TEST(TimerService, ManyThreads) {
+  yaclib::TimerService timer;
+  yaclib::FairThreadPool tp{4};
+  constexpr std::size_t kThreads = 4;
+  constexpr std::size_t kTimers = 1000;
+  yaclib_std::atomic_size_t called{0};
+  std::vector<yaclib_std::thread> threads;
+  for (std::size_t t = 0; t != kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      std::vector<yaclib::FutureOn<>> futures;
+      futures.reserve(kTimers);
+      for (std::size_t i = 0; i != kTimers; ++i) {
+        futures.push_back(timer.ScheduleAfter(tp, std::chrono::microseconds{(i * 7 + t) % 20000}));
+      }
+      for (auto& f : futures) {
+        std::move(f).DetachInline([&] {
+          called.fetch_add(1, std::memory_order_relaxed);
+        });
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  while (called.load() != kThreads * kTimers) {
+    yaclib_std::this_thread::sleep_for(1ms);
+  }
+  timer.Stop();
+  timer.Wait();
+  tp.Stop();
+  tp.Wait();
+}
+
+}  // namespace
+}  // namespace test
@@ -6,6 +6,10 @@
 
 #include <gtest/gtest.h>
 
+#if defined(GTEST_OS_LINUX) || defined(GTEST_OS_MAC)
+#  include <sys/resource.h>
+#endif
+
 namespace test::util {
 
 /* TODO(Ri7ay) dont work on windows, check thread_pool tests */
@@ -69,4 +73,17 @@ class ThreadCPUTimer {
 
 #endif
 
+#if defined(GTEST_OS_LINUX) && defined(RUSAGE_THREAD)
+
+/**
+ * Each park and wake up of the calling thread is at least one voluntary context switch, so it estimates futex syscalls
+ */
+inline std::size_t ThreadVoluntaryContextSwitches() {
+  rusage usage{};
+  getrusage(RUSAGE_THREAD, &usage);
+  return static_cast<std::size_t>(usage.ru_nvcsw);
+}
+
+#endif
+
 }  // namespace test::util